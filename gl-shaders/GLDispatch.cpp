@@ -0,0 +1,144 @@
+/// \date   October 2026
+
+#include <stdexcept>
+#include <ostream>
+#include <iostream>
+#include "GLDispatch.hpp"
+
+namespace CPM_GL_SHADERS_NS {
+
+namespace {
+
+// Forwarding functions are used instead of taking the address of the GL
+// functions directly. On platforms where GL entry points are loaded at
+// runtime (e.g. GLEW) their addresses are not known at static init time.
+#define CPM_GL_SHADERS_DEFINE_DEFAULT(ret, name, params, args) \
+  ret default##name params { return gl##name args; }
+CPM_GL_SHADERS_GL_FUNCTIONS(CPM_GL_SHADERS_DEFINE_DEFAULT)
+#undef CPM_GL_SHADERS_DEFINE_DEFAULT
+
+// Aggregate initialization keeps the tables free of static init order issues.
+const GLDispatch sDefaultDispatch =
+{
+#define CPM_GL_SHADERS_DEFAULT_ENTRY(ret, name, params, args) default##name,
+  CPM_GL_SHADERS_GL_FUNCTIONS(CPM_GL_SHADERS_DEFAULT_ENTRY)
+#undef CPM_GL_SHADERS_DEFAULT_ENTRY
+};
+
+// State of the active GLCallRecorder.
+const GLDispatch* sRecordInner = nullptr;
+uint64_t          sRecordCounts[static_cast<size_t>(GLCall::COUNT)];
+
+#define CPM_GL_SHADERS_DEFINE_RECORD(ret, name, params, args) \
+  ret record##name params \
+  { \
+    ++sRecordCounts[static_cast<size_t>(GLCall::name)]; \
+    return sRecordInner->name args; \
+  }
+CPM_GL_SHADERS_GL_FUNCTIONS(CPM_GL_SHADERS_DEFINE_RECORD)
+#undef CPM_GL_SHADERS_DEFINE_RECORD
+
+const GLDispatch sRecordDispatch =
+{
+#define CPM_GL_SHADERS_RECORD_ENTRY(ret, name, params, args) record##name,
+  CPM_GL_SHADERS_GL_FUNCTIONS(CPM_GL_SHADERS_RECORD_ENTRY)
+#undef CPM_GL_SHADERS_RECORD_ENTRY
+};
+
+const char* sCallNames[] =
+{
+#define CPM_GL_SHADERS_CALL_NAME(ret, name, params, args) "gl" #name,
+  CPM_GL_SHADERS_GL_FUNCTIONS(CPM_GL_SHADERS_CALL_NAME)
+#undef CPM_GL_SHADERS_CALL_NAME
+};
+
+} // anonymous namespace
+
+namespace detail {
+
+const GLDispatch* gCurrentGLDispatch = &sDefaultDispatch;
+
+void checkGLError(const char* stmt, const char* file, int line)
+{
+  GLenum error = glDispatch().GetError();
+  if (error == GL_NO_ERROR) return;
+
+  std::cerr << "GL error 0x" << std::hex << error << std::dec;
+  if (stmt) std::cerr << " in '" << stmt << "'";
+  std::cerr << " at " << file << ":" << line << std::endl;
+}
+
+} // namespace detail
+
+const char* getGLCallName(GLCall call)
+{
+  return sCallNames[static_cast<size_t>(call)];
+}
+
+const GLDispatch& getDefaultGLDispatch()
+{
+  return sDefaultDispatch;
+}
+
+const GLDispatch* setGLDispatch(const GLDispatch* dispatch)
+{
+  const GLDispatch* previous = detail::gCurrentGLDispatch;
+  detail::gCurrentGLDispatch = dispatch ? dispatch : &sDefaultDispatch;
+  return previous;
+}
+
+GLCallRecorder::GLCallRecorder()
+{
+  if (sRecordInner != nullptr)
+  {
+    throw std::runtime_error("GLCallRecorder: Only one recorder may be active at a time.");
+  }
+
+  sRecordInner = &glDispatch();
+  reset();
+  mPrevious = setGLDispatch(&sRecordDispatch);
+}
+
+GLCallRecorder::~GLCallRecorder()
+{
+  setGLDispatch(mPrevious);
+  sRecordInner = nullptr;
+}
+
+uint64_t GLCallRecorder::getCount(GLCall call) const
+{
+  return sRecordCounts[static_cast<size_t>(call)];
+}
+
+uint64_t GLCallRecorder::getTotal() const
+{
+  uint64_t total = 0;
+  for (size_t i = 0; i < static_cast<size_t>(GLCall::COUNT); ++i)
+  {
+    total += sRecordCounts[i];
+  }
+  return total;
+}
+
+void GLCallRecorder::reset()
+{
+  for (size_t i = 0; i < static_cast<size_t>(GLCall::COUNT); ++i)
+  {
+    sRecordCounts[i] = 0;
+  }
+}
+
+void GLCallRecorder::writeJSON(std::ostream& out) const
+{
+  out << "{";
+  bool first = true;
+  for (size_t i = 0; i < static_cast<size_t>(GLCall::COUNT); ++i)
+  {
+    if (sRecordCounts[i] == 0) continue;
+    out << (first ? "" : ", ") << "\"" << sCallNames[i] << "\": " << sRecordCounts[i];
+    first = false;
+  }
+  out << "}";
+}
+
+} // namespace CPM_GL_SHADERS_NS
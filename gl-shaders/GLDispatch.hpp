@@ -0,0 +1,219 @@
+/// \date   October 2026
+
+#ifndef IAUNS_GLDISPATCH_HPP
+#define IAUNS_GLDISPATCH_HPP
+
+#include <cstdint>
+#include <iosfwd>
+#include <gl-platform/GLPlatform.hpp>
+
+// Every OpenGL function this library calls goes through a GLDispatch table.
+// By default the table forwards to the platform's OpenGL functions. It can be
+// replaced (e.g. by NullGLBackend) to run without a GPU, and wrapped by
+// GLCallRecorder to count the calls that a piece of code issues.
+//
+// Each entry below is: X(return type, name, parameter list, argument list).
+// The name is the OpenGL function name without the 'gl' prefix.
+#define CPM_GL_SHADERS_GL_CORE_FUNCTIONS(X) \
+  X(GLenum, GetError, (), ()) \
+  X(GLuint, CreateProgram, (), ()) \
+  X(void,   DeleteProgram, (GLuint program), (program)) \
+  X(GLuint, CreateShader, (GLenum type), (type)) \
+  X(void,   DeleteShader, (GLuint shader), (shader)) \
+  X(void,   ShaderSource, (GLuint shader, GLsizei count, const GLchar* const* string, const GLint* length), (shader, count, string, length)) \
+  X(void,   CompileShader, (GLuint shader), (shader)) \
+  X(void,   GetShaderiv, (GLuint shader, GLenum pname, GLint* params), (shader, pname, params)) \
+  X(void,   GetShaderInfoLog, (GLuint shader, GLsizei bufSize, GLsizei* length, GLchar* infoLog), (shader, bufSize, length, infoLog)) \
+  X(void,   AttachShader, (GLuint program, GLuint shader), (program, shader)) \
+  X(void,   DetachShader, (GLuint program, GLuint shader), (program, shader)) \
+  X(void,   LinkProgram, (GLuint program), (program)) \
+  X(void,   GetProgramiv, (GLuint program, GLenum pname, GLint* params), (program, pname, params)) \
+  X(void,   GetProgramInfoLog, (GLuint program, GLsizei bufSize, GLsizei* length, GLchar* infoLog), (program, bufSize, length, infoLog)) \
+  X(void,   GetActiveAttrib, (GLuint program, GLuint index, GLsizei bufSize, GLsizei* length, GLint* size, GLenum* type, GLchar* name), (program, index, bufSize, length, size, type, name)) \
+  X(GLint,  GetAttribLocation, (GLuint program, const GLchar* name), (program, name)) \
+  X(void,   GetActiveUniform, (GLuint program, GLuint index, GLsizei bufSize, GLsizei* length, GLint* size, GLenum* type, GLchar* name), (program, index, bufSize, length, size, type, name)) \
+  X(GLint,  GetUniformLocation, (GLuint program, const GLchar* name), (program, name)) \
+  X(void,   GetUniformiv, (GLuint program, GLint location, GLint* params), (program, location, params)) \
+  X(void,   UseProgram, (GLuint program), (program)) \
+  X(void,   Uniform1fv, (GLint location, GLsizei count, const GLfloat* value), (location, count, value)) \
+  X(void,   Uniform2fv, (GLint location, GLsizei count, const GLfloat* value), (location, count, value)) \
+  X(void,   Uniform3fv, (GLint location, GLsizei count, const GLfloat* value), (location, count, value)) \
+  X(void,   Uniform4fv, (GLint location, GLsizei count, const GLfloat* value), (location, count, value)) \
+  X(void,   Uniform1iv, (GLint location, GLsizei count, const GLint* value), (location, count, value)) \
+  X(void,   Uniform2iv, (GLint location, GLsizei count, const GLint* value), (location, count, value)) \
+  X(void,   Uniform3iv, (GLint location, GLsizei count, const GLint* value), (location, count, value)) \
+  X(void,   Uniform4iv, (GLint location, GLsizei count, const GLint* value), (location, count, value)) \
+  X(void,   UniformMatrix2fv, (GLint location, GLsizei count, GLboolean transpose, const GLfloat* value), (location, count, transpose, value)) \
+  X(void,   UniformMatrix3fv, (GLint location, GLsizei count, GLboolean transpose, const GLfloat* value), (location, count, transpose, value)) \
+  X(void,   UniformMatrix4fv, (GLint location, GLsizei count, GLboolean transpose, const GLfloat* value), (location, count, transpose, value)) \
+  X(void,   EnableVertexAttribArray, (GLuint index), (index)) \
+  X(void,   DisableVertexAttribArray, (GLuint index), (index)) \
+  X(void,   VertexAttribPointer, (GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const void* pointer), (index, size, type, normalized, stride, pointer)) \
+  X(void,   VertexAttrib4f, (GLuint index, GLfloat x, GLfloat y, GLfloat z, GLfloat w), (index, x, y, z, w)) \
+  X(void,   GenBuffers, (GLsizei n, GLuint* buffers), (n, buffers)) \
+  X(void,   DeleteBuffers, (GLsizei n, const GLuint* buffers), (n, buffers)) \
+  X(void,   BindBuffer, (GLenum target, GLuint buffer), (target, buffer)) \
+  X(void,   BufferData, (GLenum target, GLsizeiptr size, const void* data, GLenum usage), (target, size, data, usage)) \
+  X(void,   BufferSubData, (GLenum target, GLintptr offset, GLsizeiptr size, const void* data), (target, offset, size, data)) \
+  X(void,   DrawArrays, (GLenum mode, GLint first, GLsizei count), (mode, first, count)) \
+  X(void,   DrawElements, (GLenum mode, GLsizei count, GLenum type, const void* indices), (mode, count, type, indices)) \
+  X(void,   Flush, (), ())
+
+#ifdef GL_SHADER_BINARY_FORMAT_SPIR_V
+  #define CPM_GL_SHADERS_GL_SPIRV_FUNCTIONS(X) \
+    X(void, ShaderBinary, (GLsizei count, const GLuint* shaders, GLenum binaryFormat, const void* binary, GLsizei length), (count, shaders, binaryFormat, binary, length)) \
+    X(void, SpecializeShader, (GLuint shader, const GLchar* pEntryPoint, GLuint numSpecializationConstants, const GLuint* pConstantIndex, const GLuint* pConstantValue), (shader, pEntryPoint, numSpecializationConstants, pConstantIndex, pConstantValue))
+#else
+  #define CPM_GL_SHADERS_GL_SPIRV_FUNCTIONS(X)
+#endif
+
+#ifdef GL_PROGRAM_SEPARABLE
+  #define CPM_GL_SHADERS_GL_SEPARABLE_FUNCTIONS(X) \
+    X(void, ProgramParameteri, (GLuint program, GLenum pname, GLint value), (program, pname, value)) \
+    X(void, GenProgramPipelines, (GLsizei n, GLuint* pipelines), (n, pipelines)) \
+    X(void, DeleteProgramPipelines, (GLsizei n, const GLuint* pipelines), (n, pipelines)) \
+    X(void, UseProgramStages, (GLuint pipeline, GLbitfield stages, GLuint program), (pipeline, stages, program)) \
+    X(void, ValidateProgramPipeline, (GLuint pipeline), (pipeline)) \
+    X(void, GetProgramPipelineiv, (GLuint pipeline, GLenum pname, GLint* params), (pipeline, pname, params)) \
+    X(void, GetProgramPipelineInfoLog, (GLuint pipeline, GLsizei bufSize, GLsizei* length, GLchar* infoLog), (pipeline, bufSize, length, infoLog))
+#else
+  #define CPM_GL_SHADERS_GL_SEPARABLE_FUNCTIONS(X)
+#endif
+
+#ifdef GL_SYNC_GPU_COMMANDS_COMPLETE
+  #define CPM_GL_SHADERS_GL_SYNC_FUNCTIONS(X) \
+    X(GLsync, FenceSync, (GLenum condition, GLbitfield flags), (condition, flags)) \
+    X(GLenum, ClientWaitSync, (GLsync sync, GLbitfield flags, GLuint64 timeout), (sync, flags, timeout)) \
+    X(void,   DeleteSync, (GLsync sync), (sync))
+#else
+  #define CPM_GL_SHADERS_GL_SYNC_FUNCTIONS(X)
+#endif
+
+#ifdef GL_VERTEX_ATTRIB_ARRAY_INTEGER
+  #define CPM_GL_SHADERS_GL_INTEGER_ATTRIB_FUNCTIONS(X) \
+    X(void, VertexAttribIPointer, (GLuint index, GLint size, GLenum type, GLsizei stride, const void* pointer), (index, size, type, stride, pointer)) \
+    X(void, VertexAttribI4i, (GLuint index, GLint x, GLint y, GLint z, GLint w), (index, x, y, z, w)) \
+    X(void, VertexAttribI4ui, (GLuint index, GLuint x, GLuint y, GLuint z, GLuint w), (index, x, y, z, w))
+#else
+  #define CPM_GL_SHADERS_GL_INTEGER_ATTRIB_FUNCTIONS(X)
+#endif
+
+// glMultiDrawElementsIndirect introduces no enums of its own, so the version
+// macro is the only indication that it is declared.
+#ifdef GL_VERSION_4_3
+  #define CPM_GL_SHADERS_GL_MULTI_DRAW_FUNCTIONS(X) \
+    X(void, VertexAttribDivisor, (GLuint index, GLuint divisor), (index, divisor)) \
+    X(void, MultiDrawElementsIndirect, (GLenum mode, GLenum type, const void* indirect, GLsizei drawcount, GLsizei stride), (mode, type, indirect, drawcount, stride))
+#else
+  #define CPM_GL_SHADERS_GL_MULTI_DRAW_FUNCTIONS(X)
+#endif
+
+#ifdef GL_COMPUTE_SHADER
+  #define CPM_GL_SHADERS_GL_COMPUTE_FUNCTIONS(X) \
+    X(void, GetProgramInterfaceiv, (GLuint program, GLenum programInterface, GLenum pname, GLint* params), (program, programInterface, pname, params)) \
+    X(void, GetProgramResourceName, (GLuint program, GLenum programInterface, GLuint index, GLsizei bufSize, GLsizei* length, GLchar* name), (program, programInterface, index, bufSize, length, name)) \
+    X(void, GetProgramResourceiv, (GLuint program, GLenum programInterface, GLuint index, GLsizei propCount, const GLenum* props, GLsizei count, GLsizei* length, GLint* params), (program, programInterface, index, propCount, props, count, length, params)) \
+    X(void, BindBufferBase, (GLenum target, GLuint index, GLuint buffer), (target, index, buffer)) \
+    X(void, DispatchCompute, (GLuint numGroupsX, GLuint numGroupsY, GLuint numGroupsZ), (numGroupsX, numGroupsY, numGroupsZ))
+#else
+  #define CPM_GL_SHADERS_GL_COMPUTE_FUNCTIONS(X)
+#endif
+
+#define CPM_GL_SHADERS_GL_FUNCTIONS(X) \
+  CPM_GL_SHADERS_GL_CORE_FUNCTIONS(X) \
+  CPM_GL_SHADERS_GL_SPIRV_FUNCTIONS(X) \
+  CPM_GL_SHADERS_GL_SEPARABLE_FUNCTIONS(X) \
+  CPM_GL_SHADERS_GL_SYNC_FUNCTIONS(X) \
+  CPM_GL_SHADERS_GL_INTEGER_ATTRIB_FUNCTIONS(X) \
+  CPM_GL_SHADERS_GL_MULTI_DRAW_FUNCTIONS(X) \
+  CPM_GL_SHADERS_GL_COMPUTE_FUNCTIONS(X)
+
+namespace CPM_GL_SHADERS_NS {
+
+/// Table of OpenGL entry points used by this library.
+struct GLDispatch
+{
+#define CPM_GL_SHADERS_DECLARE_ENTRY(ret, name, params, args) ret (*name) params;
+  CPM_GL_SHADERS_GL_FUNCTIONS(CPM_GL_SHADERS_DECLARE_ENTRY)
+#undef CPM_GL_SHADERS_DECLARE_ENTRY
+};
+
+/// Identifies an entry of GLDispatch.
+enum class GLCall
+{
+#define CPM_GL_SHADERS_DECLARE_CALL(ret, name, params, args) name,
+  CPM_GL_SHADERS_GL_FUNCTIONS(CPM_GL_SHADERS_DECLARE_CALL)
+#undef CPM_GL_SHADERS_DECLARE_CALL
+  COUNT
+};
+
+/// Returns the OpenGL function name (e.g. "glCreateProgram") of \p call.
+const char* getGLCallName(GLCall call);
+
+/// Dispatch table that forwards to the platform's OpenGL functions.
+const GLDispatch& getDefaultGLDispatch();
+
+namespace detail {
+extern const GLDispatch* gCurrentGLDispatch;
+}
+
+/// Retrieves the dispatch table used by this library.
+inline const GLDispatch& glDispatch() {return *detail::gCurrentGLDispatch;}
+
+namespace detail {
+/// Queries glGetError through glDispatch() and reports any error, raised by
+/// \p stmt (may be NULL) at \p file:\p line, to std::cerr.
+void checkGLError(const char* stmt, const char* file, int line);
+}
+
+/// Replaces the dispatch table used by this library. Passing nullptr restores
+/// the default table. Returns the previous table. The table must outlive its
+/// use, and must not be changed while another thread is issuing GL calls
+/// through this library.
+const GLDispatch* setGLDispatch(const GLDispatch* dispatch);
+
+/// Counts every call made through the dispatch table while it is alive. On
+/// construction it wraps the current table (real or null backend), and on
+/// destruction it restores it. Only one recorder may be active at a time, and
+/// counting is not thread safe.
+class GLCallRecorder
+{
+public:
+  GLCallRecorder();
+  ~GLCallRecorder();
+
+  /// Number of calls of the given type since construction or 'reset'.
+  uint64_t getCount(GLCall call) const;
+
+  /// Number of calls of all types since construction or 'reset'.
+  uint64_t getTotal() const;
+
+  /// Resets all counts to zero.
+  void reset();
+
+  /// Writes the non-zero counts as a JSON object of "glName": count pairs.
+  void writeJSON(std::ostream& out) const;
+
+private:
+  GLCallRecorder(const GLCallRecorder&) = delete;
+  GLCallRecorder& operator=(const GLCallRecorder&) = delete;
+
+  const GLDispatch* mPrevious;
+};
+
+} // namespace CPM_GL_SHADERS_NS
+
+// Equivalents of gl-platform's GL() and GL_CHECK() used throughout this
+// library. The error is queried through glDispatch(), so checks never reach
+// the driver while a null backend is installed and are counted by
+// GLCallRecorder. Checks are compiled out when NDEBUG is defined.
+#ifdef NDEBUG
+  #define GLD(stmt)   do { stmt; } while (0)
+  #define GLD_CHECK() do {} while (0)
+#else
+  #define GLD(stmt) \
+    do { stmt; ::CPM_GL_SHADERS_NS::detail::checkGLError(#stmt, __FILE__, __LINE__); } while (0)
+  #define GLD_CHECK() ::CPM_GL_SHADERS_NS::detail::checkGLError(NULL, __FILE__, __LINE__)
+#endif
+
+#endif
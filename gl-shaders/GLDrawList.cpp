@@ -0,0 +1,205 @@
+/// \date   October 2026
+
+#include <stdexcept>
+#include <cstring>
+#include "GLDrawList.hpp"
+#include "GLDispatch.hpp"
+
+namespace CPM_GL_SHADERS_NS {
+
+DrawPacket::DrawPacket() :
+    program(0),
+    attributes(nullptr),
+    numAttributes(0),
+    stride(0),
+    constants(nullptr),
+    numConstants(0),
+    vertexBuffer(0),
+    indexBuffer(0),
+    mode(GL_TRIANGLES),
+    count(0),
+    indexType(GL_UNSIGNED_SHORT),
+    first(0),
+    uniforms(nullptr)
+{}
+
+DrawList::DrawList() :
+    mGlobalUniforms(nullptr)
+{
+  std::memset(&mStats, 0, sizeof(mStats));
+}
+
+uint64_t DrawList::getRank(std::unordered_map<uintptr_t, uint16_t>& ranks, uintptr_t value)
+{
+  auto it = ranks.find(value);
+  if (it != ranks.end())
+  {
+    return it->second;
+  }
+  if (ranks.size() > 0xFFFF)
+  {
+    throw std::runtime_error("DrawList: Too many distinct programs, layouts, or buffers.");
+  }
+  uint16_t rank = static_cast<uint16_t>(ranks.size());
+  ranks[value] = rank;
+  return rank;
+}
+
+void DrawList::add(const DrawPacket& packet)
+{
+  uint64_t key =
+      (getRank(mProgramRanks, packet.program) << 48)
+    | (getRank(mLayoutRanks, reinterpret_cast<uintptr_t>(packet.attributes)) << 32)
+    | (getRank(mVertexBufferRanks, packet.vertexBuffer) << 16)
+    |  getRank(mIndexBufferRanks, packet.indexBuffer);
+
+  mPackets.push_back(packet);
+  mKeys.push_back(key);
+}
+
+void DrawList::clear()
+{
+  mPackets.clear();
+  mKeys.clear();
+  mProgramRanks.clear();
+  mLayoutRanks.clear();
+  mVertexBufferRanks.clear();
+  mIndexBufferRanks.clear();
+}
+
+void DrawList::radixSort(std::vector<uint64_t>& keys, std::vector<uint32_t>& indices,
+                         std::vector<uint64_t>& scratchKeys,
+                         std::vector<uint32_t>& scratchIndices)
+{
+  const size_t size = keys.size();
+  scratchKeys.resize(size);
+  scratchIndices.resize(size);
+
+  uint64_t* srcKeys    = keys.data();
+  uint32_t* srcIndices = indices.data();
+  uint64_t* dstKeys    = scratchKeys.data();
+  uint32_t* dstIndices = scratchIndices.data();
+
+  // Bits that differ between any two keys. Digits outside this mask are
+  // identical for every key and need no pass.
+  uint64_t varying = 0;
+  for (size_t i = 1; i < size; ++i)
+  {
+    varying |= srcKeys[i] ^ srcKeys[0];
+  }
+
+  for (unsigned shift = 0; shift < 64; shift += 8)
+  {
+    if (((varying >> shift) & 0xFF) == 0) continue;
+
+    size_t offsets[256] = {0};
+    for (size_t i = 0; i < size; ++i)
+    {
+      ++offsets[(srcKeys[i] >> shift) & 0xFF];
+    }
+    size_t total = 0;
+    for (size_t digit = 0; digit < 256; ++digit)
+    {
+      size_t count = offsets[digit];
+      offsets[digit] = total;
+      total += count;
+    }
+    for (size_t i = 0; i < size; ++i)
+    {
+      size_t dst = offsets[(srcKeys[i] >> shift) & 0xFF]++;
+      dstKeys[dst]    = srcKeys[i];
+      dstIndices[dst] = srcIndices[i];
+    }
+
+    std::swap(srcKeys, dstKeys);
+    std::swap(srcIndices, dstIndices);
+  }
+
+  // An odd number of passes leaves the result in the scratch buffers.
+  if (srcKeys != keys.data())
+  {
+    keys.swap(scratchKeys);
+    indices.swap(scratchIndices);
+  }
+}
+
+void DrawList::submit()
+{
+  std::memset(&mStats, 0, sizeof(mStats));
+  if (mPackets.empty()) return;
+
+  mSortKeys = mKeys;
+  mOrder.resize(mPackets.size());
+  for (size_t i = 0; i < mOrder.size(); ++i)
+  {
+    mOrder[i] = static_cast<uint32_t>(i);
+  }
+  radixSort(mSortKeys, mOrder, mScratchKeys, mScratchOrder);
+
+  const DrawPacket* bound = nullptr;
+  for (size_t i = 0; i < mOrder.size(); ++i)
+  {
+    const DrawPacket& packet = mPackets[mOrder[i]];
+
+    if (!bound || bound->program != packet.program)
+    {
+      GLD(glDispatch().UseProgram(packet.program));
+      ++mStats.programChanges;
+      if (mGlobalUniforms)
+      {
+        mGlobalUniforms->applyToProgram(packet.program);
+      }
+    }
+
+    bool layoutChanged = !bound || bound->attributes != packet.attributes
+                         || bound->constants != packet.constants;
+    bool vertexBufferChanged = !bound || bound->vertexBuffer != packet.vertexBuffer;
+    if (vertexBufferChanged)
+    {
+      GLD(glDispatch().BindBuffer(GL_ARRAY_BUFFER, packet.vertexBuffer));
+      ++mStats.bufferChanges;
+    }
+    if (!bound || bound->indexBuffer != packet.indexBuffer)
+    {
+      GLD(glDispatch().BindBuffer(GL_ELEMENT_ARRAY_BUFFER, packet.indexBuffer));
+      ++mStats.bufferChanges;
+    }
+
+    // Attribute pointers capture the bound GL_ARRAY_BUFFER, so they are
+    // respecified whenever either the layout or the vertex buffer changes.
+    if (layoutChanged || vertexBufferChanged)
+    {
+      if (bound && layoutChanged)
+      {
+        unbindPreappliedAttrib(bound->attributes, bound->numAttributes);
+      }
+      bindPreappliedAttrib(packet.attributes, packet.numAttributes, packet.stride);
+      if (layoutChanged)
+      {
+        bindPreappliedDefaults(packet.constants, packet.numConstants);
+        ++mStats.layoutChanges;
+      }
+    }
+
+    if (mUniformCallback)
+    {
+      mUniformCallback(packet.program, packet.uniforms);
+    }
+
+    if (packet.indexBuffer != 0)
+    {
+      GLD(glDispatch().DrawElements(packet.mode, packet.count, packet.indexType,
+                                    reinterpret_cast<const void*>(packet.first)));
+    }
+    else
+    {
+      GLD(glDispatch().DrawArrays(packet.mode, static_cast<GLint>(packet.first), packet.count));
+    }
+    ++mStats.draws;
+    bound = &packet;
+  }
+
+  unbindPreappliedAttrib(bound->attributes, bound->numAttributes);
+}
+
+} // namespace CPM_GL_SHADERS_NS
@@ -0,0 +1,129 @@
+/// \date   October 2026
+
+#ifndef IAUNS_GLDRAWLIST_HPP
+#define IAUNS_GLDRAWLIST_HPP
+
+#include <vector>
+#include <unordered_map>
+#include <functional>
+#include <cstdint>
+#include <gl-platform/GLPlatform.hpp>
+
+#include "GLShader.hpp"
+#include "GLGlobalUniforms.hpp"
+
+namespace CPM_GL_SHADERS_NS {
+
+/// A single draw submitted to a DrawList.
+struct DrawPacket
+{
+  DrawPacket();
+
+  GLuint  program;        ///< Program to draw with.
+
+  /// Layout built by buildPreappliedAttrib for this program and vertex buffer.
+  /// Layouts are identified by address, so draws that should share attribute
+  /// bindings must share the same array. The array must outlive 'submit'.
+  const ShaderAttributeApplied* attributes;
+  size_t  numAttributes;  ///< First tuple parameter from buildPreappliedAttrib.
+  size_t  stride;         ///< Second tuple parameter from buildPreappliedAttrib.
+
+  /// Constants built by buildPreappliedDefaults, set whenever the layout is
+  /// bound. Part of the layout's identity; may be NULL. Must outlive 'submit'.
+  const ShaderAttributeConstant* constants;
+  size_t  numConstants;   ///< Return value of buildPreappliedDefaults.
+
+  GLuint  vertexBuffer;   ///< Bound to GL_ARRAY_BUFFER.
+  GLuint  indexBuffer;    ///< Bound to GL_ELEMENT_ARRAY_BUFFER. 0 draws with glDrawArrays.
+
+  GLenum  mode;           ///< Primitive type, e.g. GL_TRIANGLES.
+  GLsizei count;          ///< Number of indices (or vertices if indexBuffer is 0).
+  GLenum  indexType;      ///< Type of the indices, e.g. GL_UNSIGNED_SHORT.
+  size_t  first;          ///< Byte offset into the index buffer, or first vertex.
+
+  /// Per-draw data passed to the DrawList's uniform callback. Not interpreted
+  /// by the draw list.
+  const void* uniforms;
+};
+
+/// Records draws in any order and submits them sorted by program, then vertex
+/// layout, then vertex and index buffer. OpenGL state is only changed where
+/// consecutive sorted draws differ, so thousands of draws that share a
+/// handful of programs cause a handful of program switches. Draws with
+/// identical state keep their submission order.
+class DrawList
+{
+public:
+  /// Called for every draw, after its program is bound, to set per-draw
+  /// uniforms.
+  typedef std::function<void (GLuint program, const void* uniforms)> UniformCallback;
+
+  /// Number of each kind of state change issued by the last 'submit'.
+  struct Stats
+  {
+    size_t draws;
+    size_t programChanges;
+    size_t layoutChanges;
+    size_t bufferChanges;
+  };
+
+  DrawList();
+
+  /// Sets the callback invoked for each draw's uniform payload.
+  void setUniformCallback(const UniformCallback& callback) {mUniformCallback = callback;}
+
+  /// Applies changed globals from \p table whenever a program is bound.
+  /// Pass NULL to disable. The table must outlive its use by 'submit'.
+  void setGlobalUniforms(GlobalUniformTable* table) {mGlobalUniforms = table;}
+
+  /// Records \p packet. At most 65536 distinct programs, layouts, vertex
+  /// buffers, and index buffers may be recorded between calls to 'clear'.
+  void add(const DrawPacket& packet);
+
+  /// Sorts and issues all recorded draws. On return the last program and
+  /// buffers remain bound and the layout's attribute arrays are disabled.
+  /// Recorded draws are kept, so the same list can be submitted again.
+  void submit();
+
+  /// Removes all recorded draws.
+  void clear();
+
+  size_t getNumDraws() const {return mPackets.size();}
+
+  /// Statistics of the last submission.
+  const Stats& getStats() const {return mStats;}
+
+  /// Sorts \p indices by the corresponding \p keys using a stable LSD radix
+  /// sort on 8-bit digits. Digits that are equal across all keys are skipped.
+  /// \p keys and \p indices are reordered in place; \p scratchKeys and
+  /// \p scratchIndices are resized as required.
+  static void radixSort(std::vector<uint64_t>& keys, std::vector<uint32_t>& indices,
+                        std::vector<uint64_t>& scratchKeys,
+                        std::vector<uint32_t>& scratchIndices);
+
+private:
+  /// Maps a GL name (or layout address) to a dense 16-bit rank so the sort
+  /// key stays 64 bits regardless of the values of the names.
+  uint64_t getRank(std::unordered_map<uintptr_t, uint16_t>& ranks, uintptr_t value);
+
+  std::vector<DrawPacket>                   mPackets;
+  std::vector<uint64_t>                     mKeys;
+  std::unordered_map<uintptr_t, uint16_t>   mProgramRanks;
+  std::unordered_map<uintptr_t, uint16_t>   mLayoutRanks;
+  std::unordered_map<uintptr_t, uint16_t>   mVertexBufferRanks;
+  std::unordered_map<uintptr_t, uint16_t>   mIndexBufferRanks;
+
+  // Scratch storage reused between submissions.
+  std::vector<uint64_t>                     mSortKeys;
+  std::vector<uint32_t>                     mOrder;
+  std::vector<uint64_t>                     mScratchKeys;
+  std::vector<uint32_t>                     mScratchOrder;
+
+  UniformCallback                           mUniformCallback;
+  GlobalUniformTable*                       mGlobalUniforms;
+  Stats                                     mStats;
+};
+
+} // namespace CPM_GL_SHADERS_NS
+
+#endif
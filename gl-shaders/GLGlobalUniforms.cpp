@@ -0,0 +1,220 @@
+/// \date   October 2026
+
+#include <stdexcept>
+#include <algorithm>
+#include "GLGlobalUniforms.hpp"
+#include "GLDispatch.hpp"
+
+namespace CPM_GL_SHADERS_NS {
+
+namespace {
+
+/// Number of components of a supported uniform type, or 0 if unsupported.
+size_t getUniformComponents(GLenum type, bool& isInteger)
+{
+  isInteger = false;
+  switch (type)
+  {
+    case GL_FLOAT:        return 1;
+    case GL_FLOAT_VEC2:   return 2;
+    case GL_FLOAT_VEC3:   return 3;
+    case GL_FLOAT_VEC4:   return 4;
+    case GL_FLOAT_MAT2:   return 2 * 2;
+    case GL_FLOAT_MAT3:   return 3 * 3;
+    case GL_FLOAT_MAT4:   return 4 * 4;
+    default:              break;
+  }
+
+  isInteger = true;
+  switch (type)
+  {
+    case GL_INT:
+    case GL_BOOL:
+    case GL_SAMPLER_2D:
+    case GL_SAMPLER_CUBE: return 1;
+    case GL_INT_VEC2:
+    case GL_BOOL_VEC2:    return 2;
+    case GL_INT_VEC3:
+    case GL_BOOL_VEC3:    return 3;
+    case GL_INT_VEC4:
+    case GL_BOOL_VEC4:    return 4;
+    default:              return 0;
+  }
+}
+
+/// Array uniforms are reported as 'name[0]'.
+std::string getBaseUniformName(const std::string& name)
+{
+  if (name.size() > 3 && name.compare(name.size() - 3, 3, "[0]") == 0)
+  {
+    return name.substr(0, name.size() - 3);
+  }
+  return name;
+}
+
+} // anonymous namespace
+
+GlobalUniformTable::GlobalID GlobalUniformTable::addGlobal(const std::string& name,
+                                                           GLenum type, GLint size)
+{
+  if (mGlobalIndex.find(name) != mGlobalIndex.end())
+  {
+    std::cerr << "GlobalUniformTable: Global '" << name << "' already declared." << std::endl;
+    throw std::runtime_error("GlobalUniformTable: Duplicate global.");
+  }
+
+  Global global;
+  global.numComps = getUniformComponents(type, global.isInteger);
+  if (global.numComps == 0 || size < 1)
+  {
+    std::cerr << "GlobalUniformTable: Unsupported type " << type << " or size " << size
+              << " for global '" << name << "'." << std::endl;
+    throw std::runtime_error("GlobalUniformTable: Unsupported global.");
+  }
+  global.name    = name;
+  global.type    = type;
+  global.size    = size;
+  global.version = 0;
+
+  size_t total = global.numComps * static_cast<size_t>(size);
+  if (global.isInteger)
+    global.ints.resize(total, 0);
+  else
+    global.floats.resize(total, 0.0f);
+
+  GlobalID id = mGlobals.size();
+  mGlobals.push_back(global);
+  mGlobalIndex[name] = id;
+
+  // Programs matched before this global existed may use it.
+  mPrograms.clear();
+  return id;
+}
+
+bool GlobalUniformTable::findGlobal(const std::string& name, GlobalID& id) const
+{
+  auto it = mGlobalIndex.find(name);
+  if (it == mGlobalIndex.end()) return false;
+  id = it->second;
+  return true;
+}
+
+const GlobalUniformTable::Global& GlobalUniformTable::getGlobal(GlobalID id) const
+{
+  if (id >= mGlobals.size())
+  {
+    throw std::runtime_error("GlobalUniformTable: Invalid global ID.");
+  }
+  return mGlobals[id];
+}
+
+void GlobalUniformTable::setFloats(GlobalID id, const GLfloat* values, size_t count)
+{
+  getGlobal(id);
+  Global& global = mGlobals[id];
+  if (global.isInteger || count != global.floats.size())
+  {
+    std::cerr << "GlobalUniformTable: Expected " << global.floats.size()
+              << " floats for global '" << global.name << "'." << std::endl;
+    throw std::runtime_error("GlobalUniformTable: Value does not match global type.");
+  }
+  std::copy(values, values + count, global.floats.begin());
+  ++global.version;
+}
+
+void GlobalUniformTable::setInts(GlobalID id, const GLint* values, size_t count)
+{
+  getGlobal(id);
+  Global& global = mGlobals[id];
+  if (!global.isInteger || count != global.ints.size())
+  {
+    std::cerr << "GlobalUniformTable: Expected " << global.ints.size()
+              << " ints for global '" << global.name << "'." << std::endl;
+    throw std::runtime_error("GlobalUniformTable: Value does not match global type.");
+  }
+  std::copy(values, values + count, global.ints.begin());
+  ++global.version;
+}
+
+uint64_t GlobalUniformTable::getVersion(GlobalID id) const
+{
+  return getGlobal(id).version;
+}
+
+std::vector<GlobalUniformTable::Binding> GlobalUniformTable::matchProgram(GLuint program) const
+{
+  std::vector<Binding> bindings;
+  std::vector<ShaderUniform> uniforms = getProgramUniforms(program);
+  for (auto it = uniforms.begin(); it != uniforms.end(); ++it)
+  {
+    auto index = mGlobalIndex.find(getBaseUniformName(it->nameInCode));
+    if (index == mGlobalIndex.end()) continue;
+
+    const Global& global = mGlobals[index->second];
+    if (global.type != it->type)
+    {
+      std::cerr << "GlobalUniformTable: Uniform '" << it->nameInCode << "' of program "
+                << program << " does not match the type of the global." << std::endl;
+      continue;
+    }
+
+    Binding binding;
+    binding.global      = index->second;
+    binding.location    = it->uniformLoc;
+    binding.count       = std::min(global.size, it->size);
+    binding.seenVersion = 0;
+    bindings.push_back(binding);
+  }
+  return bindings;
+}
+
+size_t GlobalUniformTable::applyToProgram(GLuint program)
+{
+  auto it = mPrograms.find(program);
+  if (it == mPrograms.end())
+  {
+    it = mPrograms.insert(std::make_pair(program, matchProgram(program))).first;
+  }
+
+  size_t numUploaded = 0;
+  for (auto binding = it->second.begin(); binding != it->second.end(); ++binding)
+  {
+    const Global& global = mGlobals[binding->global];
+    if (binding->seenVersion == global.version) continue;
+
+    upload(global, binding->location, binding->count);
+    binding->seenVersion = global.version;
+    ++numUploaded;
+  }
+  return numUploaded;
+}
+
+void GlobalUniformTable::forgetProgram(GLuint program)
+{
+  mPrograms.erase(program);
+}
+
+void GlobalUniformTable::upload(const Global& global, GLint location, GLsizei count)
+{
+  const GLfloat* f = global.floats.data();
+  const GLint*   i = global.ints.data();
+  switch (global.type)
+  {
+    case GL_FLOAT:        GLD(glDispatch().Uniform1fv(location, count, f)); break;
+    case GL_FLOAT_VEC2:   GLD(glDispatch().Uniform2fv(location, count, f)); break;
+    case GL_FLOAT_VEC3:   GLD(glDispatch().Uniform3fv(location, count, f)); break;
+    case GL_FLOAT_VEC4:   GLD(glDispatch().Uniform4fv(location, count, f)); break;
+    case GL_FLOAT_MAT2:   GLD(glDispatch().UniformMatrix2fv(location, count, GL_FALSE, f)); break;
+    case GL_FLOAT_MAT3:   GLD(glDispatch().UniformMatrix3fv(location, count, GL_FALSE, f)); break;
+    case GL_FLOAT_MAT4:   GLD(glDispatch().UniformMatrix4fv(location, count, GL_FALSE, f)); break;
+    case GL_INT_VEC2:
+    case GL_BOOL_VEC2:    GLD(glDispatch().Uniform2iv(location, count, i)); break;
+    case GL_INT_VEC3:
+    case GL_BOOL_VEC3:    GLD(glDispatch().Uniform3iv(location, count, i)); break;
+    case GL_INT_VEC4:
+    case GL_BOOL_VEC4:    GLD(glDispatch().Uniform4iv(location, count, i)); break;
+    default:              GLD(glDispatch().Uniform1iv(location, count, i)); break;
+  }
+}
+
+} // namespace CPM_GL_SHADERS_NS
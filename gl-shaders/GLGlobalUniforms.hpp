@@ -0,0 +1,97 @@
+/// \date   October 2026
+
+#ifndef IAUNS_GLGLOBALUNIFORMS_HPP
+#define IAUNS_GLGLOBALUNIFORMS_HPP
+
+#include <vector>
+#include <map>
+#include <string>
+#include <cstdint>
+#include <gl-platform/GLPlatform.hpp>
+
+#include "GLShader.hpp"
+
+namespace CPM_GL_SHADERS_NS {
+
+/// Uniforms shared by many programs, such as the projection matrix. Each
+/// global has a version that is bumped whenever its value is set. When a
+/// program is applied, only the globals that changed since that program last
+/// saw them are uploaded, so a per-frame constant is uploaded once per
+/// program per change rather than once per draw.
+///
+/// Globals are matched against each program's uniforms (getProgramUniforms)
+/// by name and type the first time the program is applied. Uniforms of the
+/// program that match no global are left to the caller.
+///
+/// Programs are identified by GL name, so the table can not tell when a name
+/// is relinked, whose uniforms are reset, or deleted and recycled. Call
+/// 'forgetProgram' in both cases; with ShaderReloadService, forget the old
+/// program from the reload callback.
+class GlobalUniformTable
+{
+public:
+  typedef size_t GlobalID;
+
+  /// Declares a global. \p type is a GL uniform type: float, int, and bool
+  /// scalars and vectors, square float matrices, or GL_SAMPLER_2D and
+  /// GL_SAMPLER_CUBE. \p size is the array size. Throws a runtime exception
+  /// for other types or if \p name is already declared.
+  GlobalID addGlobal(const std::string& name, GLenum type, GLint size = 1);
+
+  /// Looks up a global by name. Returns false if it has not been declared.
+  bool findGlobal(const std::string& name, GlobalID& id) const;
+
+  /// Sets the value of a float, vector, or matrix global. \p count is the
+  /// number of floats and must equal the global's components times its size.
+  void setFloats(GlobalID id, const GLfloat* values, size_t count);
+
+  /// Sets the value of an int, bool, or sampler global.
+  void setInts(GlobalID id, const GLint* values, size_t count);
+
+  /// Uploads the globals used by \p program whose value changed since they
+  /// were last applied to it. \p program must be the current program.
+  /// \return The number of globals uploaded.
+  size_t applyToProgram(GLuint program);
+
+  /// Drops the bookkeeping for \p program, e.g. after it has been deleted or
+  /// relinked. It is matched again the next time it is applied, and receives
+  /// every global.
+  void forgetProgram(GLuint program);
+
+  /// Number of times \p id has been set.
+  uint64_t getVersion(GlobalID id) const;
+
+private:
+  struct Global
+  {
+    std::string           name;
+    GLenum                type;
+    GLint                 size;
+    size_t                numComps;
+    bool                  isInteger;
+    uint64_t              version;
+    std::vector<GLfloat>  floats;
+    std::vector<GLint>    ints;
+  };
+
+  /// A global used by a program, and the version the program last received.
+  struct Binding
+  {
+    GlobalID  global;
+    GLint     location;
+    GLsizei   count;
+    uint64_t  seenVersion;
+  };
+
+  const Global& getGlobal(GlobalID id) const;
+  std::vector<Binding> matchProgram(GLuint program) const;
+  static void upload(const Global& global, GLint location, GLsizei count);
+
+  std::vector<Global>                     mGlobals;
+  std::map<std::string, GlobalID>         mGlobalIndex;
+  std::map<GLuint, std::vector<Binding>>  mPrograms;
+};
+
+} // namespace CPM_GL_SHADERS_NS
+
+#endif
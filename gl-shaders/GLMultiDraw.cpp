@@ -0,0 +1,234 @@
+/// \date   October 2026
+
+#include <stdexcept>
+#include "GLMultiDraw.hpp"
+
+#ifdef GL_VERSION_4_3
+
+namespace CPM_GL_SHADERS_NS {
+
+MeshPool::MeshPool(size_t stride, size_t maxVertices, size_t maxIndices) :
+    mStride(stride),
+    mMaxVertices(maxVertices),
+    mMaxIndices(maxIndices),
+    mNumVertices(0),
+    mNumIndices(0),
+    mVertexBuffer(0),
+    mIndexBuffer(0)
+{
+  GLD(glDispatch().GenBuffers(1, &mVertexBuffer));
+  GLD(glDispatch().GenBuffers(1, &mIndexBuffer));
+  if (0 == mVertexBuffer || 0 == mIndexBuffer)
+  {
+    throw std::runtime_error("MeshPool: Unable to create buffers using glGenBuffers.");
+  }
+
+  GLD(glDispatch().BindBuffer(GL_ARRAY_BUFFER, mVertexBuffer));
+  GLD(glDispatch().BufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(stride * maxVertices),
+                              nullptr, GL_STATIC_DRAW));
+  GLD(glDispatch().BindBuffer(GL_ELEMENT_ARRAY_BUFFER, mIndexBuffer));
+  GLD(glDispatch().BufferData(GL_ELEMENT_ARRAY_BUFFER, static_cast<GLsizeiptr>(sizeof(GLuint) * maxIndices),
+                              nullptr, GL_STATIC_DRAW));
+}
+
+MeshPool::~MeshPool()
+{
+  GLD(glDispatch().DeleteBuffers(1, &mVertexBuffer));
+  GLD(glDispatch().DeleteBuffers(1, &mIndexBuffer));
+}
+
+MeshPool::MeshID MeshPool::addMesh(const void* vertices, size_t numVertices,
+                                   const GLuint* indices, size_t numIndices)
+{
+  if (mNumVertices + numVertices > mMaxVertices || mNumIndices + numIndices > mMaxIndices)
+  {
+    std::cerr << "MeshPool: Mesh with " << numVertices << " vertices and " << numIndices
+              << " indices does not fit." << std::endl;
+    throw std::runtime_error("MeshPool: Pool is full.");
+  }
+
+  GLD(glDispatch().BindBuffer(GL_ARRAY_BUFFER, mVertexBuffer));
+  GLD(glDispatch().BufferSubData(GL_ARRAY_BUFFER, static_cast<GLintptr>(mStride * mNumVertices),
+                                 static_cast<GLsizeiptr>(mStride * numVertices), vertices));
+  GLD(glDispatch().BindBuffer(GL_ELEMENT_ARRAY_BUFFER, mIndexBuffer));
+  GLD(glDispatch().BufferSubData(GL_ELEMENT_ARRAY_BUFFER, static_cast<GLintptr>(sizeof(GLuint) * mNumIndices),
+                                 static_cast<GLsizeiptr>(sizeof(GLuint) * numIndices), indices));
+
+  Mesh mesh;
+  mesh.firstIndex = static_cast<GLuint>(mNumIndices);
+  mesh.indexCount = static_cast<GLuint>(numIndices);
+  mesh.baseVertex = static_cast<GLint>(mNumVertices);
+  mMeshes.push_back(mesh);
+
+  mNumVertices += numVertices;
+  mNumIndices  += numIndices;
+  return mMeshes.size() - 1;
+}
+
+const MeshPool::Mesh& MeshPool::getMesh(MeshID id) const
+{
+  if (id >= mMeshes.size())
+  {
+    throw std::runtime_error("MeshPool: Invalid mesh ID.");
+  }
+  return mMeshes[id];
+}
+
+MultiDrawBatcher::MultiDrawBatcher(const std::string& drawIDAttribute) :
+    mDrawIDAttribute(drawIDAttribute),
+    mNumDraws(0),
+    mIndirectBuffer(0),
+    mDrawIDBuffer(0)
+{}
+
+MultiDrawBatcher::~MultiDrawBatcher()
+{
+  if (mIndirectBuffer != 0) GLD(glDispatch().DeleteBuffers(1, &mIndirectBuffer));
+  if (mDrawIDBuffer != 0)   GLD(glDispatch().DeleteBuffers(1, &mDrawIDBuffer));
+}
+
+uint32_t MultiDrawBatcher::addDraw(GLuint program, const ShaderAttributeApplied* attributes,
+                                   size_t numAttributes, const MeshPool& pool,
+                                   MeshPool::MeshID mesh, GLuint instanceCount)
+{
+  return addDraw(program, attributes, numAttributes, nullptr, 0, pool, mesh, instanceCount);
+}
+
+uint32_t MultiDrawBatcher::addDraw(GLuint program, const ShaderAttributeApplied* attributes,
+                                   size_t numAttributes, const ShaderAttributeConstant* constants,
+                                   size_t numConstants, const MeshPool& pool,
+                                   MeshPool::MeshID mesh, GLuint instanceCount)
+{
+  // Validate now rather than at submit time.
+  pool.getMesh(mesh);
+
+  GroupKey key(program, attributes, constants, &pool);
+  auto it = mGroupIndex.find(key);
+  if (it == mGroupIndex.end())
+  {
+    Group group;
+    group.program       = program;
+    group.attributes    = attributes;
+    group.numAttributes = numAttributes;
+    group.constants     = constants;
+    group.numConstants  = numConstants;
+    group.pool          = &pool;
+    it = mGroupIndex.insert(std::make_pair(key, mGroups.size())).first;
+    mGroups.push_back(group);
+  }
+
+  Draw draw;
+  draw.drawID        = mNumDraws++;
+  draw.mesh          = mesh;
+  draw.instanceCount = instanceCount;
+  mGroups[it->second].draws.push_back(draw);
+  return draw.drawID;
+}
+
+void MultiDrawBatcher::clear()
+{
+  mGroupIndex.clear();
+  mGroups.clear();
+  mDrawIDLocations.clear();
+  mNumDraws = 0;
+}
+
+void MultiDrawBatcher::forgetProgram(GLuint program)
+{
+  mDrawIDLocations.erase(program);
+}
+
+GLint MultiDrawBatcher::getDrawIDLocation(GLuint program)
+{
+  auto it = mDrawIDLocations.find(program);
+  if (it != mDrawIDLocations.end())
+  {
+    return it->second;
+  }
+  GLint location = glDispatch().GetAttribLocation(program, mDrawIDAttribute.c_str());
+  GLD_CHECK();
+  mDrawIDLocations[program] = location;
+  return location;
+}
+
+void MultiDrawBatcher::submit(GLenum mode)
+{
+  if (mGroups.empty()) return;
+
+  // Each instance of every draw reads its draw ID from the instanced
+  // attribute at baseInstance + gl_InstanceID.
+  mCommands.clear();
+  mDrawIDs.clear();
+  for (auto group = mGroups.begin(); group != mGroups.end(); ++group)
+  {
+    for (auto draw = group->draws.begin(); draw != group->draws.end(); ++draw)
+    {
+      const MeshPool::Mesh& mesh = group->pool->getMesh(draw->mesh);
+      DrawElementsIndirectCommand command;
+      command.count         = mesh.indexCount;
+      command.instanceCount = draw->instanceCount;
+      command.firstIndex    = mesh.firstIndex;
+      command.baseVertex    = mesh.baseVertex;
+      command.baseInstance  = static_cast<GLuint>(mDrawIDs.size());
+      mCommands.push_back(command);
+      mDrawIDs.insert(mDrawIDs.end(), draw->instanceCount, draw->drawID);
+    }
+  }
+
+  if (0 == mIndirectBuffer) GLD(glDispatch().GenBuffers(1, &mIndirectBuffer));
+  if (0 == mDrawIDBuffer)   GLD(glDispatch().GenBuffers(1, &mDrawIDBuffer));
+
+  // Respecifying the whole store lets the driver orphan the previous frame's
+  // contents instead of stalling on them.
+  GLD(glDispatch().BindBuffer(GL_DRAW_INDIRECT_BUFFER, mIndirectBuffer));
+  GLD(glDispatch().BufferData(GL_DRAW_INDIRECT_BUFFER,
+                              static_cast<GLsizeiptr>(sizeof(DrawElementsIndirectCommand) * mCommands.size()),
+                              mCommands.data(), GL_STREAM_DRAW));
+  GLD(glDispatch().BindBuffer(GL_ARRAY_BUFFER, mDrawIDBuffer));
+  GLD(glDispatch().BufferData(GL_ARRAY_BUFFER,
+                              static_cast<GLsizeiptr>(sizeof(GLuint) * mDrawIDs.size()),
+                              mDrawIDs.data(), GL_STREAM_DRAW));
+
+  size_t firstCommand = 0;
+  GLuint boundProgram = 0;
+  for (auto group = mGroups.begin(); group != mGroups.end(); ++group)
+  {
+    if (group->program != boundProgram)
+    {
+      GLD(glDispatch().UseProgram(group->program));
+      boundProgram = group->program;
+    }
+
+    GLD(glDispatch().BindBuffer(GL_ARRAY_BUFFER, group->pool->getVertexBuffer()));
+    bindPreappliedAttrib(group->attributes, group->numAttributes, group->pool->getStride());
+    bindPreappliedDefaults(group->constants, group->numConstants);
+
+    GLint drawIDLoc = getDrawIDLocation(group->program);
+    if (drawIDLoc >= 0)
+    {
+      GLuint index = static_cast<GLuint>(drawIDLoc);
+      GLD(glDispatch().BindBuffer(GL_ARRAY_BUFFER, mDrawIDBuffer));
+      GLD(glDispatch().EnableVertexAttribArray(index));
+      GLD(glDispatch().VertexAttribIPointer(index, 1, GL_UNSIGNED_INT, 0, nullptr));
+      GLD(glDispatch().VertexAttribDivisor(index, 1));
+    }
+
+    GLD(glDispatch().BindBuffer(GL_ELEMENT_ARRAY_BUFFER, group->pool->getIndexBuffer()));
+    GLD(glDispatch().MultiDrawElementsIndirect(
+             mode, GL_UNSIGNED_INT,
+             reinterpret_cast<const void*>(sizeof(DrawElementsIndirectCommand) * firstCommand),
+             static_cast<GLsizei>(group->draws.size()), 0));
+    firstCommand += group->draws.size();
+
+    unbindPreappliedAttrib(group->attributes, group->numAttributes);
+    if (drawIDLoc >= 0)
+    {
+      GLD(glDispatch().VertexAttribDivisor(static_cast<GLuint>(drawIDLoc), 0));
+      GLD(glDispatch().DisableVertexAttribArray(static_cast<GLuint>(drawIDLoc)));
+    }
+  }
+}
+
+} // namespace CPM_GL_SHADERS_NS
+
+#endif // GL_VERSION_4_3
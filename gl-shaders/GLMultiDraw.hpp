@@ -0,0 +1,176 @@
+/// \date   October 2026
+
+#ifndef IAUNS_GLMULTIDRAW_HPP
+#define IAUNS_GLMULTIDRAW_HPP
+
+#include <vector>
+#include <map>
+#include <tuple>
+#include <string>
+#include <cstdint>
+#include <gl-platform/GLPlatform.hpp>
+
+#include "GLShader.hpp"
+#include "GLDispatch.hpp"
+
+// Multi-draw indirect requires OpenGL 4.3 or ARB_multi_draw_indirect.
+#ifdef GL_VERSION_4_3
+
+namespace CPM_GL_SHADERS_NS {
+
+/// Layout of one command in a GL_DRAW_INDIRECT_BUFFER, as consumed by
+/// glMultiDrawElementsIndirect.
+struct DrawElementsIndirectCommand
+{
+  GLuint  count;
+  GLuint  instanceCount;
+  GLuint  firstIndex;
+  GLint   baseVertex;
+  GLuint  baseInstance;
+};
+
+/// Vertex and index buffers shared by meshes of a single vertex format.
+/// Storage is allocated up front and meshes are sub-allocated from it, so
+/// every mesh in the pool can be drawn by one glMultiDrawElementsIndirect.
+/// Indices are GL_UNSIGNED_INT and relative to the mesh's first vertex.
+class MeshPool
+{
+public:
+  typedef size_t MeshID;
+
+  /// Location of a mesh inside the pool.
+  struct Mesh
+  {
+    GLuint  firstIndex;
+    GLuint  indexCount;
+    GLint   baseVertex;
+  };
+
+  /// Allocates buffers for \p maxVertices vertices of \p stride bytes and
+  /// \p maxIndices indices. Requires a current GL context.
+  MeshPool(size_t stride, size_t maxVertices, size_t maxIndices);
+  ~MeshPool();
+
+  /// Uploads a mesh into the pool. Throws a runtime exception if the pool
+  /// does not have room for it.
+  MeshID addMesh(const void* vertices, size_t numVertices,
+                 const GLuint* indices, size_t numIndices);
+
+  const Mesh& getMesh(MeshID id) const;
+
+  size_t getStride() const        {return mStride;}
+  GLuint getVertexBuffer() const  {return mVertexBuffer;}
+  GLuint getIndexBuffer() const   {return mIndexBuffer;}
+  size_t getNumVertices() const   {return mNumVertices;}
+  size_t getNumIndices() const    {return mNumIndices;}
+
+private:
+  MeshPool(const MeshPool&) = delete;
+  MeshPool& operator=(const MeshPool&) = delete;
+
+  size_t            mStride;
+  size_t            mMaxVertices;
+  size_t            mMaxIndices;
+  size_t            mNumVertices;
+  size_t            mNumIndices;
+  GLuint            mVertexBuffer;
+  GLuint            mIndexBuffer;
+  std::vector<Mesh> mMeshes;
+};
+
+/// Collects draws of pooled meshes and issues one glMultiDrawElementsIndirect
+/// per (program, layout, pool) group.
+///
+/// Every draw is assigned a draw ID in the order it was added. The ID is
+/// supplied to the vertex shader through an unsigned integer instanced
+/// attribute (by default 'aDrawID'), which can index per-object data held in
+/// a uniform buffer, storage buffer, or texture. Programs without that
+/// attribute are drawn without it. gl_InstanceID still counts the instances
+/// of each individual draw.
+class MultiDrawBatcher
+{
+public:
+  explicit MultiDrawBatcher(const std::string& drawIDAttribute = "aDrawID");
+  ~MultiDrawBatcher();
+
+  /// Adds a draw of \p mesh from \p pool with \p program. \p attributes is
+  /// the layout built by buildPreappliedAttrib for the pool's vertex format and
+  /// the program; draws are only batched together when they share the same
+  /// array. \p attributes and \p pool must outlive 'submit'.
+  /// \return The draw ID of this draw.
+  uint32_t addDraw(GLuint program, const ShaderAttributeApplied* attributes,
+                   size_t numAttributes, const MeshPool& pool,
+                   MeshPool::MeshID mesh, GLuint instanceCount = 1);
+
+  /// Same as above, but also sets \p constants, built by
+  /// buildPreappliedDefaults, whenever the group is drawn. Draws are only
+  /// batched together when they also share the same constants array, which
+  /// must outlive 'submit'.
+  uint32_t addDraw(GLuint program, const ShaderAttributeApplied* attributes,
+                   size_t numAttributes, const ShaderAttributeConstant* constants,
+                   size_t numConstants, const MeshPool& pool,
+                   MeshPool::MeshID mesh, GLuint instanceCount = 1);
+
+  /// Uploads the indirect commands and draw IDs and issues one multi-draw per
+  /// group. Recorded draws are kept until 'clear'.
+  void submit(GLenum mode = GL_TRIANGLES);
+
+  /// Removes all recorded draws and cached draw ID locations.
+  void clear();
+
+  /// Drops the cached draw ID location of \p program, e.g. after it has been
+  /// deleted or relinked. It is looked up again the next time it is drawn.
+  void forgetProgram(GLuint program);
+
+  size_t getNumDraws() const  {return mNumDraws;}
+  size_t getNumGroups() const {return mGroups.size();}
+
+  /// Commands uploaded by the last 'submit', ordered by group.
+  const std::vector<DrawElementsIndirectCommand>& getCommands() const {return mCommands;}
+
+private:
+  MultiDrawBatcher(const MultiDrawBatcher&) = delete;
+  MultiDrawBatcher& operator=(const MultiDrawBatcher&) = delete;
+
+  struct Draw
+  {
+    uint32_t          drawID;
+    MeshPool::MeshID  mesh;
+    GLuint            instanceCount;
+  };
+
+  struct Group
+  {
+    GLuint                          program;
+    const ShaderAttributeApplied*   attributes;
+    size_t                          numAttributes;
+    const ShaderAttributeConstant*  constants;
+    size_t                          numConstants;
+    const MeshPool*                 pool;
+    std::vector<Draw>               draws;
+  };
+
+  typedef std::tuple<GLuint, const ShaderAttributeApplied*, const ShaderAttributeConstant*,
+                     const MeshPool*> GroupKey;
+
+  /// Location of the draw ID attribute in \p program, or -1. Cached per
+  /// program until 'clear' or 'forgetProgram'.
+  GLint getDrawIDLocation(GLuint program);
+
+  std::string                                 mDrawIDAttribute;
+  std::map<GroupKey, size_t>                  mGroupIndex;
+  std::vector<Group>                          mGroups;
+  std::map<GLuint, GLint>                     mDrawIDLocations;
+  uint32_t                                    mNumDraws;
+
+  std::vector<DrawElementsIndirectCommand>    mCommands;
+  std::vector<GLuint>                         mDrawIDs;
+  GLuint                                      mIndirectBuffer;
+  GLuint                                      mDrawIDBuffer;
+};
+
+} // namespace CPM_GL_SHADERS_NS
+
+#endif // GL_VERSION_4_3
+
+#endif
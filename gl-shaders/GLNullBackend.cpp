@@ -0,0 +1,518 @@
+/// \date   October 2026
+
+#include <stdexcept>
+#include <cstring>
+#include <algorithm>
+#include <string>
+#include <cstdint>
+#include <cstdlib>
+#include "GLNullBackend.hpp"
+
+namespace CPM_GL_SHADERS_NS {
+
+namespace {
+
+template <typename... Args>
+void ignoreArgs(const Args&...) {}
+
+// Entry points that are accepted and ignored. Returns a value-initialized
+// result where one is expected (GL_NO_ERROR for glGetError).
+#define CPM_GL_SHADERS_DEFINE_NULL(ret, name, params, args) \
+  ret null##name params { ignoreArgs args; return ret(); }
+CPM_GL_SHADERS_GL_FUNCTIONS(CPM_GL_SHADERS_DEFINE_NULL)
+#undef CPM_GL_SHADERS_DEFINE_NULL
+
+const char* COMPILE_LOG = "NullGLBackend: shader compilation failed.";
+const char* LINK_LOG    = "NullGLBackend: program link failed.";
+
+void copyString(const std::string& str, GLsizei bufSize, GLsizei* length, GLchar* out)
+{
+  GLsizei written = 0;
+  if (bufSize > 0)
+  {
+    written = std::min(static_cast<GLsizei>(str.size()), bufSize - 1);
+    std::memcpy(out, str.c_str(), static_cast<size_t>(written));
+    out[written] = '\0';
+  }
+  if (length) *length = written;
+}
+
+} // anonymous namespace
+
+struct NullGLEntryPoints
+{
+  typedef std::lock_guard<std::mutex> Lock;
+
+  static NullGLBackend& backend()
+  {
+    return *NullGLBackend::sActive;
+  }
+
+  /// Looks up a program without creating it. Unknown programs report an
+  /// empty, unlinked state.
+  static const NullGLBackend::ProgramState& program(NullGLBackend& b, GLuint name)
+  {
+    static const NullGLBackend::ProgramState unknown;
+    auto it = b.mPrograms.find(name);
+    return (it != b.mPrograms.end()) ? it->second : unknown;
+  }
+
+  static GLuint CreateProgram()
+  {
+    NullGLBackend& b = backend();
+    Lock lock(b.mMutex);
+    GLuint name = b.mNextName++;
+    b.mPrograms[name] = NullGLBackend::ProgramState();
+    return name;
+  }
+
+  static void DeleteProgram(GLuint program)
+  {
+    NullGLBackend& b = backend();
+    Lock lock(b.mMutex);
+    b.mPrograms.erase(program);
+    b.mProgramOverrides.erase(program);
+  }
+
+  static GLuint CreateShader(GLenum)
+  {
+    NullGLBackend& b = backend();
+    Lock lock(b.mMutex);
+    GLuint name = b.mNextName++;
+    b.mShaders.insert(name);
+    return name;
+  }
+
+  static void DeleteShader(GLuint shader)
+  {
+    NullGLBackend& b = backend();
+    Lock lock(b.mMutex);
+    b.mShaders.erase(shader);
+  }
+
+  static void GetShaderiv(GLuint, GLenum pname, GLint* params)
+  {
+    NullGLBackend& b = backend();
+    Lock lock(b.mMutex);
+    switch (pname)
+    {
+      case GL_COMPILE_STATUS:
+        *params = b.mCompileStatus ? GL_TRUE : GL_FALSE;
+        break;
+      case GL_INFO_LOG_LENGTH:
+        *params = b.mCompileStatus ? 0 : static_cast<GLint>(std::strlen(COMPILE_LOG) + 1);
+        break;
+      default:
+        *params = 0;
+    }
+  }
+
+  static void GetShaderInfoLog(GLuint, GLsizei bufSize, GLsizei* length, GLchar* infoLog)
+  {
+    copyString(COMPILE_LOG, bufSize, length, infoLog);
+  }
+
+  static void LinkProgram(GLuint program)
+  {
+    NullGLBackend& b = backend();
+    Lock lock(b.mMutex);
+    NullGLBackend::ProgramState& state = b.mPrograms[program];
+    state.linked = b.mLinkStatus;
+
+    auto override = b.mProgramOverrides.find(program);
+    state.interface = (override != b.mProgramOverrides.end()) ? override->second
+                                                              : b.mDefaultInterface;
+  }
+
+  static void GetProgramiv(GLuint program, GLenum pname, GLint* params)
+  {
+    NullGLBackend& b = backend();
+    Lock lock(b.mMutex);
+    const NullGLBackend::ProgramState& state = NullGLEntryPoints::program(b, program);
+    const NullGLBackend::Interface& iface = state.interface;
+    switch (pname)
+    {
+      case GL_LINK_STATUS:
+        *params = state.linked ? GL_TRUE : GL_FALSE;
+        break;
+      case GL_INFO_LOG_LENGTH:
+        *params = state.linked ? 0 : static_cast<GLint>(std::strlen(LINK_LOG) + 1);
+        break;
+      case GL_ACTIVE_ATTRIBUTES:
+        *params = static_cast<GLint>(iface.attributes.size());
+        break;
+      case GL_ACTIVE_UNIFORMS:
+        *params = static_cast<GLint>(iface.uniforms.size());
+        break;
+#ifdef GL_COMPUTE_SHADER
+      case GL_COMPUTE_WORK_GROUP_SIZE:
+        std::copy(iface.workGroupSize, iface.workGroupSize + 3, params);
+        break;
+#endif
+      default:
+        *params = 0;
+    }
+  }
+
+  static void GetProgramInfoLog(GLuint, GLsizei bufSize, GLsizei* length, GLchar* infoLog)
+  {
+    copyString(LINK_LOG, bufSize, length, infoLog);
+  }
+
+  static void GetActiveAttrib(GLuint program, GLuint index, GLsizei bufSize,
+                              GLsizei* length, GLint* size, GLenum* type, GLchar* name)
+  {
+    NullGLBackend& b = backend();
+    Lock lock(b.mMutex);
+    const std::vector<ShaderAttribute>& attribs = NullGLEntryPoints::program(b, program).interface.attributes;
+    if (index >= attribs.size())
+    {
+      copyString("", bufSize, length, name);
+      return;
+    }
+    *size = attribs[index].size;
+    *type = attribs[index].type;
+    copyString(attribs[index].nameInCode, bufSize, length, name);
+  }
+
+  static GLint GetAttribLocation(GLuint program, const GLchar* name)
+  {
+    NullGLBackend& b = backend();
+    Lock lock(b.mMutex);
+    const std::vector<ShaderAttribute>& attribs = NullGLEntryPoints::program(b, program).interface.attributes;
+    for (auto it = attribs.begin(); it != attribs.end(); ++it)
+    {
+      if (it->nameInCode == name) return it->attribLoc;
+    }
+    return -1;
+  }
+
+  static void GetActiveUniform(GLuint program, GLuint index, GLsizei bufSize,
+                               GLsizei* length, GLint* size, GLenum* type, GLchar* name)
+  {
+    NullGLBackend& b = backend();
+    Lock lock(b.mMutex);
+    const std::vector<ShaderUniform>& uniforms = NullGLEntryPoints::program(b, program).interface.uniforms;
+    if (index >= uniforms.size())
+    {
+      copyString("", bufSize, length, name);
+      return;
+    }
+    *size = uniforms[index].size;
+    *type = uniforms[index].type;
+    copyString(uniforms[index].nameInCode, bufSize, length, name);
+  }
+
+  static GLint GetUniformLocation(GLuint program, const GLchar* name)
+  {
+    NullGLBackend& b = backend();
+    Lock lock(b.mMutex);
+    const std::vector<ShaderUniform>& uniforms = NullGLEntryPoints::program(b, program).interface.uniforms;
+    for (auto it = uniforms.begin(); it != uniforms.end(); ++it)
+    {
+      if (it->nameInCode == name) return it->uniformLoc;
+    }
+
+    // Array elements 'name[i]' are placed at consecutive locations.
+    std::string element(name);
+    size_t bracket = element.rfind('[');
+    if (bracket == std::string::npos) return -1;
+    std::string baseName = element.substr(0, bracket);
+    GLint index = std::atoi(element.c_str() + bracket + 1);
+    for (auto it = uniforms.begin(); it != uniforms.end(); ++it)
+    {
+      if ((it->nameInCode == baseName || it->nameInCode == baseName + "[0]")
+          && index >= 0 && index < it->size)
+      {
+        return it->uniformLoc + index;
+      }
+    }
+    return -1;
+  }
+
+  static void UseProgram(GLuint program)
+  {
+    NullGLBackend& b = backend();
+    Lock lock(b.mMutex);
+    b.mCurrentProgram = program;
+  }
+
+  static void EnableVertexAttribArray(GLuint index)
+  {
+    NullGLBackend& b = backend();
+    Lock lock(b.mMutex);
+    b.mEnabledArrays.insert(index);
+  }
+
+  static void DisableVertexAttribArray(GLuint index)
+  {
+    NullGLBackend& b = backend();
+    Lock lock(b.mMutex);
+    b.mEnabledArrays.erase(index);
+  }
+
+  static void GenBuffers(GLsizei n, GLuint* buffers)
+  {
+    NullGLBackend& b = backend();
+    Lock lock(b.mMutex);
+    for (GLsizei i = 0; i < n; ++i)
+    {
+      buffers[i] = b.mNextName++;
+      b.mBuffers.insert(buffers[i]);
+    }
+  }
+
+  static void DeleteBuffers(GLsizei n, const GLuint* buffers)
+  {
+    NullGLBackend& b = backend();
+    Lock lock(b.mMutex);
+    for (GLsizei i = 0; i < n; ++i)
+    {
+      b.mBuffers.erase(buffers[i]);
+    }
+  }
+
+#ifdef GL_COMPUTE_SHADER
+  /// Only shader storage blocks are reported; other interfaces are empty.
+  static void GetProgramInterfaceiv(GLuint program, GLenum programInterface,
+                                    GLenum pname, GLint* params)
+  {
+    NullGLBackend& b = backend();
+    Lock lock(b.mMutex);
+    const std::vector<ShaderStorageBlock>& blocks = NullGLEntryPoints::program(b, program).interface.storageBlocks;
+    *params = 0;
+    if (programInterface != GL_SHADER_STORAGE_BLOCK) return;
+
+    if (pname == GL_ACTIVE_RESOURCES)
+    {
+      *params = static_cast<GLint>(blocks.size());
+    }
+    else if (pname == GL_MAX_NAME_LENGTH)
+    {
+      for (auto it = blocks.begin(); it != blocks.end(); ++it)
+      {
+        *params = std::max(*params, static_cast<GLint>(it->nameInCode.size() + 1));
+      }
+    }
+  }
+
+  static void GetProgramResourceName(GLuint program, GLenum programInterface, GLuint index,
+                                     GLsizei bufSize, GLsizei* length, GLchar* name)
+  {
+    NullGLBackend& b = backend();
+    Lock lock(b.mMutex);
+    const std::vector<ShaderStorageBlock>& blocks = NullGLEntryPoints::program(b, program).interface.storageBlocks;
+    if (programInterface != GL_SHADER_STORAGE_BLOCK || index >= blocks.size())
+    {
+      copyString("", bufSize, length, name);
+      return;
+    }
+    copyString(blocks[index].nameInCode, bufSize, length, name);
+  }
+
+  static void GetProgramResourceiv(GLuint program, GLenum programInterface, GLuint index,
+                                   GLsizei propCount, const GLenum* props, GLsizei count,
+                                   GLsizei* length, GLint* params)
+  {
+    NullGLBackend& b = backend();
+    Lock lock(b.mMutex);
+    const std::vector<ShaderStorageBlock>& blocks = NullGLEntryPoints::program(b, program).interface.storageBlocks;
+    GLsizei written = std::min(propCount, count);
+    for (GLsizei i = 0; i < written; ++i)
+    {
+      params[i] = 0;
+      if (programInterface != GL_SHADER_STORAGE_BLOCK || index >= blocks.size()) continue;
+      if (props[i] == GL_BUFFER_BINDING)   params[i] = blocks[index].binding;
+      if (props[i] == GL_BUFFER_DATA_SIZE) params[i] = blocks[index].dataSize;
+    }
+    if (length) *length = written;
+  }
+#endif
+
+#ifdef GL_SYNC_GPU_COMMANDS_COMPLETE
+  /// Fences are signaled as soon as they are created.
+  static GLsync FenceSync(GLenum, GLbitfield)
+  {
+    NullGLBackend& b = backend();
+    Lock lock(b.mMutex);
+    return reinterpret_cast<GLsync>(static_cast<uintptr_t>(b.mNextName++));
+  }
+
+  static GLenum ClientWaitSync(GLsync, GLbitfield, GLuint64)
+  {
+    return GL_ALREADY_SIGNALED;
+  }
+#endif
+
+#ifdef GL_PROGRAM_SEPARABLE
+  static void GenProgramPipelines(GLsizei n, GLuint* pipelines)
+  {
+    NullGLBackend& b = backend();
+    Lock lock(b.mMutex);
+    for (GLsizei i = 0; i < n; ++i)
+    {
+      pipelines[i] = b.mNextName++;
+    }
+  }
+
+  static void GetProgramPipelineiv(GLuint, GLenum pname, GLint* params)
+  {
+    *params = (pname == GL_VALIDATE_STATUS) ? GL_TRUE : 0;
+  }
+#endif
+};
+
+NullGLBackend* NullGLBackend::sActive = nullptr;
+
+NullGLBackend::Interface::Interface()
+{
+#ifdef GL_COMPUTE_SHADER
+  workGroupSize[0] = workGroupSize[1] = workGroupSize[2] = 0;
+#endif
+}
+
+NullGLBackend::NullGLBackend() :
+    mNextName(1),
+    mCurrentProgram(0),
+    mCompileStatus(true),
+    mLinkStatus(true)
+{
+  if (sActive != nullptr)
+  {
+    throw std::runtime_error("NullGLBackend: Only one backend may be active at a time.");
+  }
+
+  GLDispatch dispatch =
+  {
+#define CPM_GL_SHADERS_NULL_ENTRY(ret, name, params, args) null##name,
+    CPM_GL_SHADERS_GL_FUNCTIONS(CPM_GL_SHADERS_NULL_ENTRY)
+#undef CPM_GL_SHADERS_NULL_ENTRY
+  };
+  mDispatch = dispatch;
+
+  mDispatch.CreateProgram             = NullGLEntryPoints::CreateProgram;
+  mDispatch.DeleteProgram             = NullGLEntryPoints::DeleteProgram;
+  mDispatch.CreateShader              = NullGLEntryPoints::CreateShader;
+  mDispatch.DeleteShader              = NullGLEntryPoints::DeleteShader;
+  mDispatch.GetShaderiv               = NullGLEntryPoints::GetShaderiv;
+  mDispatch.GetShaderInfoLog          = NullGLEntryPoints::GetShaderInfoLog;
+  mDispatch.LinkProgram               = NullGLEntryPoints::LinkProgram;
+  mDispatch.GetProgramiv              = NullGLEntryPoints::GetProgramiv;
+  mDispatch.GetProgramInfoLog         = NullGLEntryPoints::GetProgramInfoLog;
+  mDispatch.GetActiveAttrib           = NullGLEntryPoints::GetActiveAttrib;
+  mDispatch.GetAttribLocation         = NullGLEntryPoints::GetAttribLocation;
+  mDispatch.GetActiveUniform          = NullGLEntryPoints::GetActiveUniform;
+  mDispatch.GetUniformLocation        = NullGLEntryPoints::GetUniformLocation;
+  mDispatch.UseProgram                = NullGLEntryPoints::UseProgram;
+  mDispatch.EnableVertexAttribArray   = NullGLEntryPoints::EnableVertexAttribArray;
+  mDispatch.DisableVertexAttribArray  = NullGLEntryPoints::DisableVertexAttribArray;
+  mDispatch.GenBuffers                = NullGLEntryPoints::GenBuffers;
+  mDispatch.DeleteBuffers             = NullGLEntryPoints::DeleteBuffers;
+#ifdef GL_COMPUTE_SHADER
+  mDispatch.GetProgramInterfaceiv     = NullGLEntryPoints::GetProgramInterfaceiv;
+  mDispatch.GetProgramResourceName    = NullGLEntryPoints::GetProgramResourceName;
+  mDispatch.GetProgramResourceiv      = NullGLEntryPoints::GetProgramResourceiv;
+#endif
+#ifdef GL_SYNC_GPU_COMMANDS_COMPLETE
+  mDispatch.FenceSync                 = NullGLEntryPoints::FenceSync;
+  mDispatch.ClientWaitSync            = NullGLEntryPoints::ClientWaitSync;
+#endif
+#ifdef GL_PROGRAM_SEPARABLE
+  mDispatch.GenProgramPipelines       = NullGLEntryPoints::GenProgramPipelines;
+  mDispatch.GetProgramPipelineiv      = NullGLEntryPoints::GetProgramPipelineiv;
+#endif
+
+  sActive = this;
+  mPrevious = setGLDispatch(&mDispatch);
+}
+
+NullGLBackend::~NullGLBackend()
+{
+  setGLDispatch(mPrevious);
+  sActive = nullptr;
+}
+
+void NullGLBackend::setProgramInterface(const std::vector<ShaderAttribute>& attributes,
+                                        const std::vector<ShaderUniform>& uniforms)
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  mDefaultInterface.attributes = attributes;
+  mDefaultInterface.uniforms   = uniforms;
+}
+
+#ifdef GL_COMPUTE_SHADER
+void NullGLBackend::setComputeInterface(const GLint workGroupSize[3],
+                                        const std::vector<ShaderStorageBlock>& storageBlocks)
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  std::copy(workGroupSize, workGroupSize + 3, mDefaultInterface.workGroupSize);
+  mDefaultInterface.storageBlocks = storageBlocks;
+}
+#endif
+
+void NullGLBackend::setProgramInterface(GLuint program,
+                                        const std::vector<ShaderAttribute>& attributes,
+                                        const std::vector<ShaderUniform>& uniforms)
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  Interface& iface = mProgramOverrides[program];
+  iface.attributes = attributes;
+  iface.uniforms   = uniforms;
+
+  // Apply immediately if the program has already been linked.
+  auto it = mPrograms.find(program);
+  if (it != mPrograms.end() && it->second.linked)
+  {
+    it->second.interface = iface;
+  }
+}
+
+void NullGLBackend::setCompileStatus(bool success)
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  mCompileStatus = success;
+}
+
+void NullGLBackend::setLinkStatus(bool success)
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  mLinkStatus = success;
+}
+
+size_t NullGLBackend::getNumLiveShaders() const
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  return mShaders.size();
+}
+
+size_t NullGLBackend::getNumLivePrograms() const
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  return mPrograms.size();
+}
+
+size_t NullGLBackend::getNumLiveBuffers() const
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  return mBuffers.size();
+}
+
+GLuint NullGLBackend::getCurrentProgram() const
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  return mCurrentProgram;
+}
+
+bool NullGLBackend::isAttribArrayEnabled(GLuint index) const
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  return mEnabledArrays.find(index) != mEnabledArrays.end();
+}
+
+size_t NullGLBackend::getNumEnabledAttribArrays() const
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  return mEnabledArrays.size();
+}
+
+} // namespace CPM_GL_SHADERS_NS
@@ -0,0 +1,119 @@
+/// \date   October 2026
+
+#ifndef IAUNS_GLNULLBACKEND_HPP
+#define IAUNS_GLNULLBACKEND_HPP
+
+#include <vector>
+#include <map>
+#include <set>
+#include <mutex>
+#include <gl-platform/GLPlatform.hpp>
+
+#include "GLShader.hpp"
+#include "GLDispatch.hpp"
+#include "GLShaderCompute.hpp"
+
+namespace CPM_GL_SHADERS_NS {
+
+/// GL backend that requires no context or GPU. Shader, program, pipeline, and
+/// buffer objects are faked: compiles and links succeed (unless configured
+/// otherwise), and linked programs report the attributes and uniforms given by
+/// 'setProgramInterface'. Fence syncs are signaled as soon as they are
+/// created and glGetError always reports GL_NO_ERROR. All other calls are
+/// accepted and ignored.
+///
+/// The backend installs itself through setGLDispatch on construction and
+/// restores the previous table on destruction. Only one backend may be active
+/// at a time. Object creation is guarded by a mutex so objects may be created
+/// from a worker thread.
+class NullGLBackend
+{
+public:
+  NullGLBackend();
+  ~NullGLBackend();
+
+  /// Interface reported by every program linked from now on.
+  void setProgramInterface(const std::vector<ShaderAttribute>& attributes,
+                           const std::vector<ShaderUniform>& uniforms);
+
+  /// Interface reported by a specific program. Overrides the above.
+  void setProgramInterface(GLuint program,
+                           const std::vector<ShaderAttribute>& attributes,
+                           const std::vector<ShaderUniform>& uniforms);
+
+#ifdef GL_COMPUTE_SHADER
+  /// Local work-group size and storage blocks reported by every program
+  /// linked from now on, through GL_COMPUTE_WORK_GROUP_SIZE and the program
+  /// interface query. Programs report no compute stage by default.
+  void setComputeInterface(const GLint workGroupSize[3],
+                           const std::vector<ShaderStorageBlock>& storageBlocks);
+#endif
+
+  /// Result of subsequent compiles and links. Both succeed by default.
+  void setCompileStatus(bool success);
+  void setLinkStatus(bool success);
+
+  /// Number of shader and program objects that have not been deleted.
+  size_t getNumLiveShaders() const;
+  size_t getNumLivePrograms() const;
+
+  /// Number of buffer objects that have not been deleted.
+  size_t getNumLiveBuffers() const;
+
+  /// Program most recently passed to glUseProgram.
+  GLuint getCurrentProgram() const;
+
+  /// True if glEnableVertexAttribArray was called for \p index more recently
+  /// than glDisableVertexAttribArray.
+  bool isAttribArrayEnabled(GLuint index) const;
+
+  /// Number of vertex attribute arrays currently enabled.
+  size_t getNumEnabledAttribArrays() const;
+
+private:
+  NullGLBackend(const NullGLBackend&) = delete;
+  NullGLBackend& operator=(const NullGLBackend&) = delete;
+
+  /// Fake GL entry points, defined in GLNullBackend.cpp.
+  friend struct NullGLEntryPoints;
+
+  struct Interface
+  {
+    Interface();
+
+    std::vector<ShaderAttribute>    attributes;
+    std::vector<ShaderUniform>      uniforms;
+#ifdef GL_COMPUTE_SHADER
+    GLint                           workGroupSize[3];
+    std::vector<ShaderStorageBlock> storageBlocks;
+#endif
+  };
+
+  struct ProgramState
+  {
+    ProgramState() : linked(false) {}
+
+    bool      linked;
+    Interface interface;
+  };
+
+  mutable std::mutex              mMutex;
+  GLuint                          mNextName;
+  std::set<GLuint>                mShaders;
+  std::set<GLuint>                mBuffers;
+  std::map<GLuint, ProgramState>  mPrograms;
+  std::map<GLuint, Interface>     mProgramOverrides;
+  Interface                       mDefaultInterface;
+  std::set<GLuint>                mEnabledArrays;
+  GLuint                          mCurrentProgram;
+  bool                            mCompileStatus;
+  bool                            mLinkStatus;
+
+  GLDispatch            mDispatch;
+  const GLDispatch*     mPrevious;
+  static NullGLBackend* sActive;
+};
+
+} // namespace CPM_GL_SHADERS_NS
+
+#endif
@@ -5,7 +5,11 @@
 #include <cstring>
 #include <algorithm>
 #include <functional>
+#include <chrono>
 #include "GLShader.hpp"
+#include "GLDispatch.hpp"
+#include "GLShaderTelemetry.hpp"
+#include "GLShaderUsage.hpp"
 
 namespace CPM_GL_SHADERS_NS {
 
@@ -17,10 +21,217 @@ size_t getNumComponentsOfGLType(GLenum type);
 GLenum getBaseTypeOfGLType(GLenum type);
 size_t getSizeOfBaseGLType(GLenum type);
 
+ShaderSource::ShaderSource(const void* binary, size_t binarySize, GLenum shaderType,
+                           const char* entryPoint,
+                           const std::vector<GLuint>& constantIndices,
+                           const std::vector<GLuint>& constantValues) :
+    mShaderType(shaderType),
+    mBinary(binary),
+    mBinarySize(binarySize),
+    mEntryPoint(entryPoint),
+    mConstantIndices(constantIndices),
+    mConstantValues(constantValues)
+{
+  if (NULL == entryPoint)
+  {
+    std::cerr << "ShaderSource: SPIR-V module requires an entry point." << std::endl;
+    throw std::runtime_error("SPIR-V entry point is NULL.");
+  }
+}
+
+namespace {
+
+/// Retrieves a shader or program info log using the given GL entry points.
+template <typename GetivFunc, typename GetLogFunc>
+std::string getInfoLog(GLuint object, GetivFunc getiv, GetLogFunc getLog)
+{
+  GLint infoLen = 0;
+  GLD(getiv(object, GL_INFO_LOG_LENGTH, &infoLen));
+  if (infoLen <= 1)
+  {
+    return std::string();
+  }
+
+  std::vector<char> infoLog(static_cast<size_t>(infoLen));
+  GLD(getLog(object, infoLen, NULL, &infoLog[0]));
+  return std::string(&infoLog[0]);
+}
+
+/// Compiles a shader. Returns 0 if compilation failed, in which case the
+/// shader is deleted and its log is written to std::cerr. If \p log is not
+/// NULL it receives the info log, even on success (e.g. warnings).
+GLuint compileShaderWithLog(const ShaderSource& shaderSource, std::string* log)
+{
+  GLuint shader = glDispatch().CreateShader(shaderSource.mShaderType);
+  GLD_CHECK();
+  if (0 == shader)
+  {
+    throw std::runtime_error("Failed to create shader using glCreateShader");
+  }
+
+  if (shaderSource.isBinary())
+  {
+#ifdef GL_SHADER_BINARY_FORMAT_SPIR_V
+    // Load the SPIR-V module and specialize it. Specialization takes the
+    // place of compilation and sets the compile status.
+    if (shaderSource.mConstantIndices.size() != shaderSource.mConstantValues.size())
+    {
+      GLD(glDispatch().DeleteShader(shader));
+      throw std::runtime_error("Mismatched specialization constant indices and values.");
+    }
+    GLD(glDispatch().ShaderBinary(1, &shader, GL_SHADER_BINARY_FORMAT_SPIR_V,
+                                  shaderSource.mBinary,
+                                  static_cast<GLsizei>(shaderSource.mBinarySize)));
+    GLD(glDispatch().SpecializeShader(
+             shader, shaderSource.mEntryPoint,
+             static_cast<GLuint>(shaderSource.mConstantIndices.size()),
+             shaderSource.mConstantIndices.empty() ? NULL : &shaderSource.mConstantIndices[0],
+             shaderSource.mConstantValues.empty() ? NULL : &shaderSource.mConstantValues[0]));
+#else
+    GLD(glDispatch().DeleteShader(shader));
+    throw std::runtime_error("SPIR-V shaders are not supported on this platform.");
+#endif
+  }
+  else
+  {
+    // Set the source and compile.
+    std::string fullSource;
+    for (const char* source : shaderSource.mSources)
+    {
+      fullSource += source;
+    }
+    const char* contents = fullSource.c_str();
+    GLD(glDispatch().ShaderSource(shader, 1, &contents, NULL));
+    GLD(glDispatch().CompileShader(shader));
+  }
+
+  // Check the compile status.
+  GLint compiled;
+  GLD(glDispatch().GetShaderiv(shader, GL_COMPILE_STATUS, &compiled));
+  if (!compiled)
+  {
+    std::string infoLog = getInfoLog(shader, glDispatch().GetShaderiv,
+                                     glDispatch().GetShaderInfoLog);
+    if (!infoLog.empty())
+    {
+      std::cerr << "Error compiling shader:" << std::endl << infoLog << std::endl;
+    }
+    if (log) *log = infoLog;
+
+    GLD(glDispatch().DeleteShader(shader));
+    return 0;
+  }
+
+  if (log)
+  {
+    *log = getInfoLog(shader, glDispatch().GetShaderiv, glDispatch().GetShaderInfoLog);
+  }
+  return shader;
+}
+
+/// Links a program. Returns false if linking failed, in which case the log is
+/// written to std::cerr. If \p log is not NULL it receives the info log.
+bool linkProgramWithLog(GLuint program, std::string* log)
+{
+  GLD(glDispatch().LinkProgram(program));
+
+  // Check the link status
+  GLint linked;
+  GLD(glDispatch().GetProgramiv(program, GL_LINK_STATUS, &linked));
+  if (!linked)
+  {
+    std::string infoLog = getInfoLog(program, glDispatch().GetProgramiv,
+                                     glDispatch().GetProgramInfoLog);
+    if (!infoLog.empty())
+    {
+      std::cerr << "Error linking program:" << std::endl;
+      std::cerr << infoLog << std::endl;
+    }
+    if (log) *log = infoLog;
+    return false;
+  }
+
+  if (log)
+  {
+    *log = getInfoLog(program, glDispatch().GetProgramiv, glDispatch().GetProgramInfoLog);
+  }
+  return true;
+}
+
+double secondsSince(std::chrono::steady_clock::time_point start)
+{
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+size_t getSourceBytes(const ShaderSource& shader)
+{
+  if (shader.isBinary())
+  {
+    return shader.mBinarySize;
+  }
+
+  size_t bytes = 0;
+  for (const char* source : shader.mSources)
+  {
+    bytes += std::strlen(source);
+  }
+  return bytes;
+}
+
+/// Sets a disabled attribute array to a constant value.
+void applyAttributeConstant(GLint attribLoc, GLenum baseType, const GLfloat values[4])
+{
+  GLuint index = static_cast<GLuint>(attribLoc);
+#ifdef GL_VERTEX_ATTRIB_ARRAY_INTEGER
+  if (baseType == GL_UNSIGNED_INT)
+  {
+    GLD(glDispatch().VertexAttribI4ui(index,
+                                      static_cast<GLuint>(values[0]), static_cast<GLuint>(values[1]),
+                                      static_cast<GLuint>(values[2]), static_cast<GLuint>(values[3])));
+    return;
+  }
+  if (baseType == GL_INT)
+  {
+    GLD(glDispatch().VertexAttribI4i(index,
+                                     static_cast<GLint>(values[0]), static_cast<GLint>(values[1]),
+                                     static_cast<GLint>(values[2]), static_cast<GLint>(values[3])));
+    return;
+  }
+#else
+  (void)baseType;
+#endif
+  GLD(glDispatch().VertexAttrib4f(index, values[0], values[1], values[2], values[3]));
+}
+
+} // anonymous namespace
+
+GLuint compileShader(const ShaderSource& shaderSource)
+{
+  GLuint shader = compileShaderWithLog(shaderSource, NULL);
+  if (0 == shader)
+  {
+    throw std::runtime_error("Failed to compile shader.");
+  }
+  return shader;
+}
+
+void linkProgram(GLuint program)
+{
+  if (!linkProgramWithLog(program, NULL))
+  {
+    throw std::runtime_error("Failed to link shader.");
+  }
+}
+
 GLuint loadShaderProgram(const std::list<ShaderSource>& shaders)
 {
-  GLuint program = glCreateProgram();
-  GL_CHECK();
+  return loadShaderProgram(shaders, std::string());
+}
+
+GLuint loadShaderProgram(const std::list<ShaderSource>& shaders, const std::string& label)
+{
+  GLuint program = glDispatch().CreateProgram();
+  GLD_CHECK();
   if (0 == program)
   {
     // This usually indicates an invalid context.
@@ -28,6 +239,17 @@ GLuint loadShaderProgram(const std::list<ShaderSource>& shaders)
     return 0;
   }
 
+  // Telemetry is only gathered when a sink is installed. Otherwise no
+  // additional GL calls are made.
+  ShaderTelemetry* telemetry = getShaderTelemetry();
+  ProgramTelemetry record;
+  if (telemetry)
+  {
+    record.sourceHash = hashShaderSources(shaders);
+    record.label      = label;
+    record.program    = program;
+  }
+
   // Vector of compiled shaders alongside a function to delete the program and
   // all shaders.
   std::vector<GLuint> compiledShaders;
@@ -35,95 +257,90 @@ GLuint loadShaderProgram(const std::list<ShaderSource>& shaders)
   {
     for (auto compShader = compiledShaders.begin(); compShader != compiledShaders.end(); ++compShader)
     {
-      glDeleteShader(*compShader);
+      GLD(glDispatch().DeleteShader(*compShader));
     }
   };
   auto deleteProgramAndShaders = [&]()
   {
     deleteShaders();
-    glDeleteProgram(program);
+    GLD(glDispatch().DeleteProgram(program));
   };
 
   // Compile all shaders.
   int idx = 0;
   for (auto it = shaders.begin(); it != shaders.end(); ++it)
   {
-    GLuint shader = glCreateShader(it->mShaderType);
-    GL_CHECK();
-    if (0 == shader)
+    ShaderStageTelemetry stage;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    GLuint shader = 0;
+    try
+    {
+      shader = compileShaderWithLog(*it, telemetry ? &stage.log : NULL);
+    }
+    catch (...)
     {
       deleteProgramAndShaders();
-      throw std::runtime_error("Failed to create shader using glCreateShader");
+      throw;
     }
 
-    // Add shader to list now, so it will be removed via any call to
-    // deleteProgramAndShaders.
-    compiledShaders.push_back(shader);
-
-    // Set the source and compile.
-    std::string fullSource;
-    for (const char* source : it->mSources)
+    if (telemetry)
     {
-      fullSource += source;
+      stage.shaderType     = it->mShaderType;
+      stage.sourceBytes    = getSourceBytes(*it);
+      stage.compileSeconds = secondsSince(start);
+      stage.success        = (shader != 0);
+      record.stages.push_back(stage);
+      record.compileSeconds += stage.compileSeconds;
     }
-    const char* contents = fullSource.c_str();
-    GL(glShaderSource(shader, 1, &contents, NULL));
-    GL(glCompileShader(shader));
 
-    // Check the compile status.
-    GLint compiled;
-    GL(glGetShaderiv(shader, GL_COMPILE_STATUS, &compiled));
-    if (!compiled)
+    if (0 == shader)
     {
-      GLint infoLen = 0;
-
-      GL(glGetShaderiv(shader, GL_INFO_LOG_LENGTH, &infoLen));
-      if (infoLen > 1)
-      {
-        char* infoLog = new char[infoLen];
-
-        GL(glGetShaderInfoLog(shader, infoLen, NULL, infoLog));
-        std::cerr << "Error compiling shader program with index " << idx << ":"
-                  << std::endl << infoLog << std::endl;
-
-        delete[] infoLog;
-      }
-
+      std::cerr << "Error compiling shader program with index " << idx << "." << std::endl;
       deleteProgramAndShaders();
+      if (telemetry) telemetry->record(record);
       throw std::runtime_error("Failed to compile shader.");
     }
 
+    // Add shader to list now, so it will be removed via any call to
+    // deleteProgramAndShaders.
+    compiledShaders.push_back(shader);
+
     // Attach the shader to the program
-    GL(glAttachShader(program, shader));
+    GLD(glDispatch().AttachShader(program, shader));
 
     ++idx;
   }
 
   // Link program.
-  GL(glLinkProgram(program));
-
-	// Check the link status 
-	GLint linked;
-	GL(glGetProgramiv(program, GL_LINK_STATUS, &linked));
-	if (!linked)
-	{
-		GLint infoLen = 0;
-		GL(glGetProgramiv(program, GL_INFO_LOG_LENGTH, &infoLen));
-
-		if (infoLen > 1)
-		{
-      char* infoLog = new char[infoLen];
-
-			GL(glGetProgramInfoLog(program, infoLen, NULL, infoLog));
-      std::cerr << "Error linking program:" << std::endl;
-      std::cerr << infoLog << std::endl;
-
-      delete[] infoLog;
-		}
+  std::chrono::steady_clock::time_point linkStart = std::chrono::steady_clock::now();
+  bool linked = linkProgramWithLog(program, telemetry ? &record.linkLog : NULL);
+  if (telemetry)
+  {
+    record.linkSeconds = secondsSince(linkStart);
+    record.success     = linked;
+#ifdef GL_PROGRAM_BINARY_LENGTH
+    if (linked)
+    {
+      GLint binaryLength = 0;
+      GLD(glDispatch().GetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &binaryLength));
+      record.binaryBytes = static_cast<size_t>(binaryLength);
+    }
+#endif
+    telemetry->record(record);
+  }
 
+  if (!linked)
+  {
     deleteProgramAndShaders();
     throw std::runtime_error("Failed to link shader.");
-	}
+  }
+
+  ShaderUsageRecorder* usage = getShaderUsageRecorder();
+  if (usage)
+  {
+    usage->recordLoad(hashShaderSources(shaders));
+  }
 
   // Remove unnecessary compiled shaders.
   deleteShaders();
@@ -131,11 +348,65 @@ GLuint loadShaderProgram(const std::list<ShaderSource>& shaders)
   return program;
 }
 
+namespace {
+
+const uint64_t FNV_OFFSET_BASIS = 0xcbf29ce484222325ull;
+const uint64_t FNV_PRIME        = 0x100000001b3ull;
+
+uint64_t fnv1a(const void* data, size_t size, uint64_t hash)
+{
+  const unsigned char* bytes = static_cast<const unsigned char*>(data);
+  for (size_t i = 0; i < size; ++i)
+  {
+    hash ^= bytes[i];
+    hash *= FNV_PRIME;
+  }
+  return hash;
+}
+
+} // anonymous namespace
+
+uint64_t hashShaderSource(const ShaderSource& shader)
+{
+  uint64_t hash = fnv1a(&shader.mShaderType, sizeof(shader.mShaderType), FNV_OFFSET_BASIS);
+  if (shader.isBinary())
+  {
+    hash = fnv1a(shader.mBinary, shader.mBinarySize, hash);
+    hash = fnv1a(shader.mEntryPoint, std::strlen(shader.mEntryPoint), hash);
+    for (size_t i = 0; i < shader.mConstantIndices.size(); ++i)
+    {
+      hash = fnv1a(&shader.mConstantIndices[i], sizeof(GLuint), hash);
+    }
+    for (size_t i = 0; i < shader.mConstantValues.size(); ++i)
+    {
+      hash = fnv1a(&shader.mConstantValues[i], sizeof(GLuint), hash);
+    }
+    return hash;
+  }
+
+  for (const char* source : shader.mSources)
+  {
+    hash = fnv1a(source, std::strlen(source), hash);
+  }
+  return hash;
+}
+
+uint64_t hashShaderSources(const std::list<ShaderSource>& shaders)
+{
+  uint64_t hash = FNV_OFFSET_BASIS;
+  for (auto it = shaders.begin(); it != shaders.end(); ++it)
+  {
+    uint64_t shaderHash = hashShaderSource(*it);
+    hash = fnv1a(&shaderHash, sizeof(shaderHash), hash);
+  }
+  return hash;
+}
+
 std::vector<ShaderAttribute> getProgramAttributes(GLuint program)
 {
   // Check the active attributes.
   GLint activeAttributes;
-  GL(glGetProgramiv(program, GL_ACTIVE_ATTRIBUTES, &activeAttributes));
+  GLD(glDispatch().GetProgramiv(program, GL_ACTIVE_ATTRIBUTES, &activeAttributes));
 
   std::vector<ShaderAttribute> attributes;
   const int maxAttribNameSize = GL_ACTIVE_ATTRIBUTE_MAX_LENGTH;
@@ -146,10 +417,10 @@ std::vector<ShaderAttribute> getProgramAttributes(GLuint program)
     GLint attribSize;
     GLenum type;
 
-    GL(glGetActiveAttrib(program, static_cast<GLuint>(i), maxAttribNameSize,
-                         &charsWritten, &attribSize, &type, attributeName));
+    GLD(glDispatch().GetActiveAttrib(program, static_cast<GLuint>(i), maxAttribNameSize,
+                          &charsWritten, &attribSize, &type, attributeName));
 
-    GLint loc = glGetAttribLocation(program, attributeName);
+    GLint loc = glDispatch().GetAttribLocation(program, attributeName);
 
     attributes.push_back(ShaderAttribute(attributeName, attribSize, type, loc));
   }
@@ -172,10 +443,10 @@ void bindAllAttributes(const ShaderAttribute* array, size_t size)
   size_t offset = 0;
   for (size_t i = 0; i < size; ++i)
   {
-    GL(glEnableVertexAttribArray(static_cast<GLuint>(array[i].attribLoc)));
-    GL(glVertexAttribPointer(static_cast<GLuint>(array[i].attribLoc),
-                             array[i].numComps, array[i].baseType, array[i].normalize,
-                             stride, reinterpret_cast<const void*>(offset)));
+    GLD(glDispatch().EnableVertexAttribArray(static_cast<GLuint>(array[i].attribLoc)));
+    GLD(glDispatch().VertexAttribPointer(static_cast<GLuint>(array[i].attribLoc),
+                              array[i].numComps, array[i].baseType, array[i].normalize,
+                              stride, reinterpret_cast<const void*>(offset)));
     offset += array[i].sizeBytes;
   }
 }
@@ -184,10 +455,36 @@ void unbindAllAttributes(const ShaderAttribute* array, size_t size)
 {
   for (size_t i = 0; i < size; ++i)
   {
-    GL(glDisableVertexAttribArray(static_cast<GLuint>(array[i].attribLoc)));
+    GLD(glDispatch().DisableVertexAttribArray(static_cast<GLuint>(array[i].attribLoc)));
   }
 }
 
+namespace {
+
+/// Enables and points the arrays of \p subset's attributes found in
+/// \p superset.
+void bindSubsetArrays(const ShaderAttribute* superset, size_t supersetSize,
+                      const ShaderAttribute* subset, size_t subsetSize)
+{
+  GLsizei stride = calculateStride(superset, supersetSize);
+  size_t offset = 0;
+  for (size_t i = 0; i < supersetSize; ++i)
+  {
+    int attribIndex = hasAttribute(subset, subsetSize, superset[i].nameInCode);
+    if (attribIndex != -1)
+    {
+      GLD(glDispatch().EnableVertexAttribArray(static_cast<GLuint>(subset[attribIndex].attribLoc)));
+      GLD(glDispatch().VertexAttribPointer(static_cast<GLuint>(subset[attribIndex].attribLoc),
+                                subset[attribIndex].numComps, subset[attribIndex].baseType,
+                                superset[i].normalize, stride, 
+                                reinterpret_cast<const void*>(offset)));
+    }
+    offset += superset[i].sizeBytes;
+  }
+}
+
+} // anonymous namespace
+
 void bindSubsetAttributes(const ShaderAttribute* superset, size_t supersetSize,
                           const ShaderAttribute* subset, size_t subsetSize)
 {
@@ -198,20 +495,49 @@ void bindSubsetAttributes(const ShaderAttribute* superset, size_t supersetSize,
     std::cerr << "instead of bindSubsetAttributes." << std::endl;
   }
 
-  GLsizei stride = calculateStride(superset, supersetSize);
-  size_t offset = 0;
-  for (size_t i = 0; i < supersetSize; ++i)
+  bindSubsetArrays(superset, supersetSize, subset, subsetSize);
+}
+
+ShaderAttributeDefault::ShaderAttributeDefault(const std::string& name, GLfloat x,
+                                               GLfloat y, GLfloat z, GLfloat w) :
+    nameInCode(name)
+{
+  values[0] = x;
+  values[1] = y;
+  values[2] = z;
+  values[3] = w;
+}
+
+int hasAttributeDefault(const ShaderAttributeDefault* array, size_t size,
+                        const std::string& name)
+{
+  for (size_t i = 0; i < size; ++i)
   {
-    int attribIndex = hasAttribute(subset, subsetSize, superset[i].nameInCode);
-    if (attribIndex != -1)
+    if (array[i].nameInCode == name)
+      return static_cast<int>(i);
+  }
+  return -1;
+}
+
+void bindSubsetAttributes(const ShaderAttribute* superset, size_t supersetSize,
+                          const ShaderAttribute* subset, size_t subsetSize,
+                          const ShaderAttributeDefault* defaults, size_t defaultsSize)
+{
+  bindSubsetArrays(superset, supersetSize, subset, subsetSize);
+
+  for (size_t i = 0; i < subsetSize; ++i)
+  {
+    if (hasAttribute(superset, supersetSize, subset[i].nameInCode) != -1) continue;
+
+    int defaultIndex = hasAttributeDefault(defaults, defaultsSize, subset[i].nameInCode);
+    if (defaultIndex == -1)
     {
-      GL(glEnableVertexAttribArray(static_cast<GLuint>(subset[attribIndex].attribLoc)));
-      GL(glVertexAttribPointer(static_cast<GLuint>(subset[attribIndex].attribLoc),
-                               subset[attribIndex].numComps, subset[attribIndex].baseType,
-                               superset[i].normalize, stride, 
-                               reinterpret_cast<const void*>(offset)));
+      std::cerr << "bindSubsetAttributes: No data or default for attribute "
+                << subset[i].nameInCode << std::endl;
+      throw std::runtime_error("Unsatisfied shader attribute.");
     }
-    offset += superset[i].sizeBytes;
+    applyAttributeConstant(subset[i].attribLoc, subset[i].baseType,
+                           defaults[defaultIndex].values);
   }
 }
 
@@ -223,7 +549,7 @@ void unbindSubsetAttributes(const ShaderAttribute* superset, size_t supersetSize
     int attribIndex = hasAttribute(subset, subsetSize, superset[i].nameInCode);
     if (attribIndex != -1)
     {
-      GL(glDisableVertexAttribArray(static_cast<GLuint>(subset[attribIndex].attribLoc)));
+      GLD(glDispatch().DisableVertexAttribArray(static_cast<GLuint>(subset[attribIndex].attribLoc)));
     }
   }
 }
@@ -263,16 +589,46 @@ std::tuple<size_t, size_t> buildPreappliedAttrib(
   return std::make_tuple(appliedSize, stride);
 }
 
+size_t buildPreappliedDefaults(
+    const ShaderAttribute* superset, size_t supersetSize,
+    const ShaderAttribute* subset, size_t subsetSize,
+    const ShaderAttributeDefault* defaults, size_t defaultsSize,
+    ShaderAttributeConstant* out, size_t outMaxSize)
+{
+  size_t constantSize = 0;
+  for (size_t i = 0; i < subsetSize; ++i)
+  {
+    if (hasAttribute(superset, supersetSize, subset[i].nameInCode) != -1) continue;
+
+    int defaultIndex = hasAttributeDefault(defaults, defaultsSize, subset[i].nameInCode);
+    if (defaultIndex == -1) continue;
+
+    if (constantSize == outMaxSize)
+    {
+      std::cerr << "cpm-gl-shaders - buildPreappliedDefaults: outMaxSize too small" << std::endl;
+      throw std::runtime_error("outMaxSize too small.");
+    }
+
+    out[constantSize].attribLoc = subset[i].attribLoc;
+    out[constantSize].baseType  = subset[i].baseType;
+    std::copy(defaults[defaultIndex].values, defaults[defaultIndex].values + 4,
+              out[constantSize].values);
+    ++constantSize;
+  }
+
+  return constantSize;
+}
+
 
 
 void bindPreappliedAttrib(const ShaderAttributeApplied* array, size_t size, size_t stride)
 {
   for (size_t i = 0; i < size; ++i)
   {
-    GL(glEnableVertexAttribArray(static_cast<GLuint>(array[i].attribLoc)));
-    GL(glVertexAttribPointer(static_cast<GLuint>(array[i].attribLoc),
-                             array[i].numComps, array[i].baseType, array[i].normalize,
-                             stride, reinterpret_cast<const void*>(array[i].offset)));
+    GLD(glDispatch().EnableVertexAttribArray(static_cast<GLuint>(array[i].attribLoc)));
+    GLD(glDispatch().VertexAttribPointer(static_cast<GLuint>(array[i].attribLoc),
+                              array[i].numComps, array[i].baseType, array[i].normalize,
+                              stride, reinterpret_cast<const void*>(array[i].offset)));
   }
 }
 
@@ -280,7 +636,15 @@ void unbindPreappliedAttrib(const ShaderAttributeApplied* array, size_t size)
 {
   for (size_t i = 0; i < size; ++i)  
   {
-    GL(glDisableVertexAttribArray(static_cast<GLuint>(array[i].attribLoc)));
+    GLD(glDispatch().DisableVertexAttribArray(static_cast<GLuint>(array[i].attribLoc)));
+  }
+}
+
+void bindPreappliedDefaults(const ShaderAttributeConstant* array, size_t size)
+{
+  for (size_t i = 0; i < size; ++i)
+  {
+    applyAttributeConstant(array[i].attribLoc, array[i].baseType, array[i].values);
   }
 }
 
@@ -299,7 +663,7 @@ GLsizei calculateStride(const ShaderAttribute* array, size_t size)
 std::vector<ShaderUniform> getProgramUniforms(GLuint program)
 {
   GLint activeUniforms;
-  GL(glGetProgramiv(program, GL_ACTIVE_UNIFORMS, &activeUniforms));
+  GLD(glDispatch().GetProgramiv(program, GL_ACTIVE_UNIFORMS, &activeUniforms));
 
   std::vector<ShaderUniform> uniforms;
   const int maxUniformNameSize = GL_ACTIVE_UNIFORM_MAX_LENGTH;
@@ -310,10 +674,10 @@ std::vector<ShaderUniform> getProgramUniforms(GLuint program)
     GLint uniformSize;
     GLenum type;
 
-    GL(glGetActiveUniform(program, static_cast<GLuint>(i), maxUniformNameSize,
-                          &charsWritten, &uniformSize, &type, uniformName));
+    GLD(glDispatch().GetActiveUniform(program, static_cast<GLuint>(i), maxUniformNameSize,
+                           &charsWritten, &uniformSize, &type, uniformName));
 
-    GLint loc = glGetUniformLocation(program, uniformName);
+    GLint loc = glDispatch().GetUniformLocation(program, uniformName);
 
     uniforms.push_back(ShaderUniform(uniformName, uniformSize, type, loc));
   }
@@ -9,6 +9,7 @@
 #include <list>
 #include <tuple>
 #include <cstdint>
+#include <string>
 #include <gl-platform/GLPlatform.hpp>
 
 namespace CPM_GL_SHADERS_NS {
@@ -21,11 +22,46 @@ struct ShaderSource
   ///               GL_GEOMETRY_SHADER, GL_FRAGMENT_SHADER
   ShaderSource(const std::vector<const char*>& sources, GLenum shaderType) :
       mSources(sources),
-      mShaderType(shaderType)
+      mShaderType(shaderType),
+      mBinary(nullptr),
+      mBinarySize(0),
+      mEntryPoint(nullptr)
   {}
 
+  /// Precompiled SPIR-V module. Input directly into 'glShaderBinary' and
+  /// specialized with 'glSpecializeShader'. Requires OpenGL 4.6; compiling
+  /// throws a runtime exception on platforms without SPIR-V support.
+  ///
+  /// SPIR-V programs only report attribute and uniform names if the module
+  /// was built with debug info (e.g. glslangValidator -g). Without it,
+  /// getProgramAttributes and getProgramUniforms return empty or unnamed
+  /// entries, so everything matching by name (bindSubsetAttributes,
+  /// VertexLayoutRegistry, GlobalUniformTable) finds nothing. Use explicit
+  /// locations and bindings in that case.
+  /// \p binary           SPIR-V module. Not copied, must outlive compilation.
+  /// \p binarySize       Size of \p binary in bytes.
+  /// \p shaderType       Same as above.
+  /// \p entryPoint       Name of the module's entry point. Throws a runtime
+  ///                     exception if NULL.
+  /// \p constantIndices  Specialization constant IDs.
+  /// \p constantValues   Specialization constant values, one per ID.
+  ShaderSource(const void* binary, size_t binarySize, GLenum shaderType,
+               const char* entryPoint = "main",
+               const std::vector<GLuint>& constantIndices = std::vector<GLuint>(),
+               const std::vector<GLuint>& constantValues = std::vector<GLuint>());
+
+  /// True if this source holds a SPIR-V module instead of GLSL text.
+  bool isBinary() const {return mBinary != nullptr;}
+
   std::vector<const char*>  mSources;
   GLenum                    mShaderType;
+
+  // SPIR-V only.
+  const void*               mBinary;
+  size_t                    mBinarySize;
+  const char*               mEntryPoint;
+  std::vector<GLuint>       mConstantIndices;
+  std::vector<GLuint>       mConstantValues;
 };
 
 /// Mimics glCreateProgram. Loads, compiles, and links shaders then returns the
@@ -33,6 +69,30 @@ struct ShaderSource
 /// important information regarding errors.
 GLuint loadShaderProgram(const std::list<ShaderSource>& shaders);
 
+/// Same as above. \p label identifies the program in telemetry reports (see
+/// setShaderTelemetry). Programs without a label are reported by source hash.
+GLuint loadShaderProgram(const std::list<ShaderSource>& shaders, const std::string& label);
+
+/// Creates and compiles a single shader object from \p shader. Throws a
+/// runtime exception if compilation fails; the compile log is written to
+/// std::cerr. Use this alongside linkProgram when shader objects must outlive
+/// the link (e.g. to relink a program after only one stage changed).
+GLuint compileShader(const ShaderSource& shader);
+
+/// Links \p program, whose shaders must already be attached. Throws a runtime
+/// exception if linking fails; the link log is written to std::cerr. The
+/// program is not deleted on failure.
+void linkProgram(GLuint program);
+
+/// Computes a 64-bit FNV-1a hash of the shader type and the concatenation of
+/// all of the shader's sources (or of the SPIR-V module, entry point, and
+/// specialization constants). Suitable for identifying a shader across runs.
+uint64_t hashShaderSource(const ShaderSource& shader);
+
+/// Combines the hashes of all shaders, in order, into a single hash that
+/// identifies the program built from \p shaders.
+uint64_t hashShaderSources(const std::list<ShaderSource>& shaders);
+
 struct ShaderAttribute
 {
   ShaderAttribute();
@@ -73,6 +133,7 @@ bool operator!=(const ShaderAttribute& a, const ShaderAttribute& b);
 int hasAttribute(const ShaderAttribute* array, size_t size, const std::string& name);
 
 /// Collects all shader attributes into a vector of ShaderAttribute.
+/// Attributes of SPIR-V stages are only named if the module has debug info.
 std::vector<ShaderAttribute> getProgramAttributes(GLuint program);
 
 /// Sorts a vector of shader attributes alphabetically by 'nameInCode'.
@@ -99,6 +160,33 @@ void bindSubsetAttributes(const ShaderAttribute* superset, size_t supersetSize,
 void unbindSubsetAttributes(const ShaderAttribute* superset, size_t supersetSize,
                             const ShaderAttribute* subset, size_t subsetSize);
 
+/// Constant value for a shader attribute that a VBO does not supply. Applied
+/// with glVertexAttrib4f (or glVertexAttribI4i for integer attributes) while
+/// the attribute's array is disabled, instead of padding the VBO with a
+/// stream of identical values.
+struct ShaderAttributeDefault
+{
+  ShaderAttributeDefault(const std::string& name, GLfloat x, GLfloat y = 0.0f,
+                         GLfloat z = 0.0f, GLfloat w = 1.0f);
+
+  std::string nameInCode;   ///< Name of the attribute in-code.
+  GLfloat     values[4];    ///< Converted to integers for integer attributes.
+};
+
+/// Determines if the given default array has a default for 'name'.
+/// \return -1 if no default exists, otherwise the index of the default.
+int hasAttributeDefault(const ShaderAttributeDefault* array, size_t size,
+                        const std::string& name);
+
+/// Same as bindSubsetAttributes, but attributes of \p subset that are missing
+/// from \p superset are set to their constant value from \p defaults. Throws a
+/// runtime exception if a missing attribute has no default. Attribute arrays
+/// must be disabled for the constants to take effect, which is the case after
+/// any of the unbind functions.
+void bindSubsetAttributes(const ShaderAttribute* superset, size_t supersetSize,
+                          const ShaderAttribute* subset, size_t subsetSize,
+                          const ShaderAttributeDefault* defaults, size_t defaultsSize);
+
 /// Minimal structure based on the intersection between shader and VBO.
 struct ShaderAttributeApplied
 {
@@ -109,6 +197,15 @@ struct ShaderAttributeApplied
   uint32_t    offset;       ///< Calculated offset into VBO's memory.
 };
 
+/// Constant value of a shader attribute that the VBO does not supply. Built
+/// by buildPreappliedDefaults alongside the ShaderAttributeApplied array.
+struct ShaderAttributeConstant
+{
+  GLint       attribLoc;    ///< Attribute location from the shader.
+  GLenum      baseType;     ///< Selects glVertexAttrib4f, I4i, or I4ui.
+  GLfloat     values[4];    ///< Taken from the matching ShaderAttributeDefault.
+};
+
 /// Builds a sequence of applied attributes. Use this to set set up a VBO for 
 /// rendering with a particular shader. If an error occurs, a runtime exception
 /// will be thrown, but the tuple <0,0> will be returned on systems that do not
@@ -133,6 +230,17 @@ std::tuple<size_t, size_t> buildPreappliedAttrib(
     const ShaderAttribute* subset, size_t subsetSize,
     ShaderAttributeApplied* out, size_t outMaxSize);
 
+/// Builds the constants for attributes of \p subset that are missing from
+/// \p superset and have an entry in \p defaults. Attributes without a
+/// default are skipped, as in buildPreappliedAttrib. Throws a runtime
+/// exception if \p outMaxSize is too small.
+/// \return Number of constants written to \p out.
+size_t buildPreappliedDefaults(
+    const ShaderAttribute* superset, size_t supersetSize,
+    const ShaderAttribute* subset, size_t subsetSize,
+    const ShaderAttributeDefault* defaults, size_t defaultsSize,
+    ShaderAttributeConstant* out, size_t outMaxSize);
+
 /// Binds shader attributes based off of the intersection of a superset and
 /// subset as calculated prior by buildPreAppliedAttrib. This function is more
 /// efficient and cache friendly than bindAllAttributes or bindSubsetAttributes.
@@ -145,6 +253,14 @@ void bindPreappliedAttrib(const ShaderAttributeApplied* array, size_t size,
 /// Unbind all attributes bound in bindPreappliedAttrib.
 void unbindPreappliedAttrib(const ShaderAttributeApplied* array, size_t size);
 
+/// Sets the constants built by buildPreappliedDefaults with glVertexAttrib*.
+/// Their attribute arrays must be disabled for the constants to take effect,
+/// which is the case after any of the unbind functions. Constants need no
+/// unbinding.
+/// \param array  \p out from buildPreappliedDefaults.
+/// \param size   Return value of buildPreappliedDefaults.
+void bindPreappliedDefaults(const ShaderAttributeConstant* array, size_t size);
+
 /// Generic structure for holding a shader uniform.
 struct ShaderUniform
 {
@@ -160,6 +276,7 @@ bool operator==(const ShaderUniform& a, const ShaderUniform& b);
 bool operator!=(const ShaderUniform& a, const ShaderUniform& b);
 
 /// Collects all shader uniforms into a vector of ShaderUniform.
+/// Uniforms of SPIR-V stages are only named if the module has debug info.
 std::vector<ShaderUniform> getProgramUniforms(GLuint program);
 
 } // namespace CPM_GL_SHADER_NS 
@@ -0,0 +1,258 @@
+/// \date   October 2026
+
+#include <stdexcept>
+#include "GLShaderCompileService.hpp"
+#include "GLDispatch.hpp"
+
+#ifdef GL_SYNC_GPU_COMMANDS_COMPLETE
+
+namespace CPM_GL_SHADERS_NS {
+
+ShaderCompileService::ShaderCompileService(const ShaderCompileContextFactory& factory) :
+    mBuilding(0),
+    mNextTicket(1),
+    mStop(false)
+{
+  mContext = factory();
+  if (!mContext)
+  {
+    throw std::runtime_error("ShaderCompileService: Context factory returned no context.");
+  }
+  mWorker = std::thread(&ShaderCompileService::workerMain, this);
+}
+
+ShaderCompileService::~ShaderCompileService()
+{
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mStop = true;
+  }
+  mWorkAvailable.notify_all();
+  mWorker.join();
+}
+
+ShaderCompileService::Ticket ShaderCompileService::submit(
+    const std::list<ShaderSource>& shaders, const std::string& label)
+{
+  Job job;
+  job.label = label;
+  for (auto it = shaders.begin(); it != shaders.end(); ++it)
+  {
+    OwnedSource source;
+    source.shaderType = it->mShaderType;
+    if (it->isBinary())
+    {
+      const char* binary = static_cast<const char*>(it->mBinary);
+      source.binary.assign(binary, binary + it->mBinarySize);
+      source.entryPoint      = it->mEntryPoint ? it->mEntryPoint : "main";
+      source.constantIndices = it->mConstantIndices;
+      source.constantValues  = it->mConstantValues;
+    }
+    else
+    {
+      for (auto text = it->mSources.begin(); text != it->mSources.end(); ++text)
+      {
+        source.text += *text;
+      }
+    }
+    job.sources.push_back(std::move(source));
+  }
+
+  Ticket ticket;
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    ticket = mNextTicket++;
+    job.ticket = ticket;
+    mQueue.push_back(std::move(job));
+    if (!mContextError.empty())
+    {
+      // The worker is gone; fail the ticket right away.
+      failQueuedJobs(mContextError);
+      return ticket;
+    }
+  }
+  mWorkAvailable.notify_one();
+  return ticket;
+}
+
+bool ShaderCompileService::isSignaled(const Finished& finished) const
+{
+  if (finished.fence == 0)
+  {
+    return true;
+  }
+  // A zero timeout never blocks the render thread.
+  GLenum result = glDispatch().ClientWaitSync(finished.fence, 0, 0);
+  GLD_CHECK();
+  return result == GL_ALREADY_SIGNALED || result == GL_CONDITION_SATISFIED;
+}
+
+ShaderCompileService::Status ShaderCompileService::poll(
+    Ticket ticket, GLuint& program, std::string* error)
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  auto it = mFinished.find(ticket);
+  if (it == mFinished.end())
+  {
+    for (auto job = mQueue.begin(); job != mQueue.end(); ++job)
+    {
+      if (job->ticket == ticket) return STATUS_PENDING;
+    }
+    return (ticket == mBuilding) ? STATUS_PENDING : STATUS_UNKNOWN;
+  }
+
+  if (!isSignaled(it->second))
+  {
+    return STATUS_PENDING;
+  }
+
+  Status status = STATUS_READY;
+  if (it->second.program == 0)
+  {
+    status = STATUS_FAILED;
+    if (error) *error = it->second.error;
+  }
+  if (it->second.fence != 0)
+  {
+    GLD(glDispatch().DeleteSync(it->second.fence));
+  }
+  program = it->second.program;
+  mFinished.erase(it);
+  return status;
+}
+
+std::vector<ShaderCompileService::Result> ShaderCompileService::collect()
+{
+  std::vector<Result> results;
+  std::lock_guard<std::mutex> lock(mMutex);
+  for (auto it = mFinished.begin(); it != mFinished.end();)
+  {
+    if (!isSignaled(it->second))
+    {
+      ++it;
+      continue;
+    }
+
+    if (it->second.fence != 0)
+    {
+      GLD(glDispatch().DeleteSync(it->second.fence));
+    }
+    Result result;
+    result.ticket  = it->first;
+    result.program = it->second.program;
+    result.error   = it->second.error;
+    results.push_back(result);
+    it = mFinished.erase(it);
+  }
+  return results;
+}
+
+void ShaderCompileService::waitIdle()
+{
+  std::unique_lock<std::mutex> lock(mMutex);
+  mIdle.wait(lock, [this] {return mQueue.empty() && mBuilding == 0;});
+}
+
+size_t ShaderCompileService::getNumQueued() const
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  return mQueue.size() + (mBuilding != 0 ? 1 : 0);
+}
+
+void ShaderCompileService::failQueuedJobs(const std::string& error)
+{
+  for (auto job = mQueue.begin(); job != mQueue.end(); ++job)
+  {
+    Finished finished;
+    finished.program = 0;
+    finished.fence   = 0;
+    finished.error   = error;
+    mFinished[job->ticket] = finished;
+  }
+  mQueue.clear();
+}
+
+void ShaderCompileService::workerMain()
+{
+  try
+  {
+    mContext->makeCurrent();
+  }
+  catch (const std::exception& e)
+  {
+    std::cerr << "ShaderCompileService: Unable to make the worker context current: "
+              << e.what() << std::endl;
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    mContextError = std::string("Worker context unavailable: ") + e.what();
+    failQueuedJobs(mContextError);
+    mIdle.notify_all();
+    return;
+  }
+
+  std::unique_lock<std::mutex> lock(mMutex);
+  for (;;)
+  {
+    mWorkAvailable.wait(lock, [this] {return mStop || !mQueue.empty();});
+    if (mStop) break;
+
+    Job job = std::move(mQueue.front());
+    mQueue.pop_front();
+    mBuilding = job.ticket;
+    lock.unlock();
+
+    std::list<ShaderSource> shaders;
+    for (auto it = job.sources.begin(); it != job.sources.end(); ++it)
+    {
+      if (!it->binary.empty())
+      {
+        shaders.push_back(ShaderSource(&it->binary[0], it->binary.size(), it->shaderType,
+                                       it->entryPoint.c_str(),
+                                       it->constantIndices, it->constantValues));
+      }
+      else
+      {
+        shaders.push_back(ShaderSource({it->text.c_str()}, it->shaderType));
+      }
+    }
+
+    Finished finished;
+    finished.program = 0;
+    finished.fence   = 0;
+    try
+    {
+      finished.program = loadShaderProgram(shaders, job.label);
+      finished.fence   = glDispatch().FenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+      GLD_CHECK();
+      // The fence must reach the GPU before another context can wait on it.
+      GLD(glDispatch().Flush());
+    }
+    catch (const std::exception& e)
+    {
+      finished.error = e.what();
+    }
+
+    lock.lock();
+    mFinished[job.ticket] = finished;
+    mBuilding = 0;
+    if (mQueue.empty() && mBuilding == 0)
+    {
+      mIdle.notify_all();
+    }
+  }
+
+  // Nobody will retrieve these anymore.
+  for (auto it = mFinished.begin(); it != mFinished.end(); ++it)
+  {
+    if (it->second.fence != 0)   GLD(glDispatch().DeleteSync(it->second.fence));
+    if (it->second.program != 0) GLD(glDispatch().DeleteProgram(it->second.program));
+  }
+  mFinished.clear();
+  lock.unlock();
+
+  mContext->doneCurrent();
+}
+
+} // namespace CPM_GL_SHADERS_NS
+
+#endif // GL_SYNC_GPU_COMMANDS_COMPLETE
@@ -0,0 +1,156 @@
+/// \date   October 2026
+
+#ifndef IAUNS_GLSHADERCOMPILESERVICE_HPP
+#define IAUNS_GLSHADERCOMPILESERVICE_HPP
+
+#include <vector>
+#include <list>
+#include <map>
+#include <deque>
+#include <string>
+#include <memory>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <cstdint>
+#include <gl-platform/GLPlatform.hpp>
+
+#include "GLShader.hpp"
+
+// Fence syncs require OpenGL 3.2, ARB_sync, or OpenGL ES 3.0.
+#ifdef GL_SYNC_GPU_COMMANDS_COMPLETE
+
+namespace CPM_GL_SHADERS_NS {
+
+/// GL context used by the compile worker. It must share objects with the
+/// render thread's context. Implement this for the windowing system in use,
+/// or with a fake for testing.
+class ShaderCompileContext
+{
+public:
+  virtual ~ShaderCompileContext() {}
+
+  /// Makes the context current on the calling (worker) thread. May throw a
+  /// runtime exception, in which case the service fails every ticket.
+  virtual void makeCurrent() = 0;
+
+  /// Releases the context from the calling (worker) thread.
+  virtual void doneCurrent() = 0;
+};
+
+/// Creates the worker's shared context. Called once, on the thread that
+/// constructs the ShaderCompileService, which must have the render context
+/// current if the windowing system requires it for sharing.
+typedef std::function<std::unique_ptr<ShaderCompileContext> ()> ShaderCompileContextFactory;
+
+/// Compiles and links programs on a worker thread that owns a shared GL
+/// context, keeping compilation off the render thread. Finished programs are
+/// published with a fence sync, and are only handed to the render thread once
+/// the fence has signaled, so they are safe to use.
+///
+/// If the worker context can not be made current the worker stops, and every
+/// queued and future ticket fails with the context's error.
+class ShaderCompileService
+{
+public:
+  typedef uint64_t Ticket;
+
+  enum Status
+  {
+    STATUS_PENDING,   ///< Queued, compiling, or waiting on its fence.
+    STATUS_READY,     ///< Program handed to the caller.
+    STATUS_FAILED,    ///< Compile or link failed.
+    STATUS_UNKNOWN,   ///< Ticket was never issued or was already retrieved.
+  };
+
+  struct Result
+  {
+    Ticket      ticket;
+    GLuint      program;  ///< 0 if the build failed.
+    std::string error;    ///< Exception message if the build failed.
+  };
+
+  /// Creates the worker context with \p factory and starts the worker thread.
+  explicit ShaderCompileService(const ShaderCompileContextFactory& factory);
+
+  /// Stops the worker. Programs that were never retrieved are deleted.
+  ~ShaderCompileService();
+
+  /// Queues a program for compilation. Sources (GLSL text or SPIR-V) are
+  /// copied, so the caller's buffers may be released immediately. \p label
+  /// identifies the program in telemetry (see loadShaderProgram).
+  Ticket submit(const std::list<ShaderSource>& shaders, const std::string& label = "");
+
+  /// Render thread. Checks whether the given program is ready. On
+  /// STATUS_READY \p program receives the program, which the caller now owns.
+  /// On STATUS_FAILED \p error (if not NULL) receives the failure message.
+  Status poll(Ticket ticket, GLuint& program, std::string* error = NULL);
+
+  /// Render thread. Retrieves every program whose fence has signaled and every
+  /// failed build. The caller owns the returned programs.
+  std::vector<Result> collect();
+
+  /// Blocks until the worker has finished every submitted program. Fences may
+  /// still be pending afterwards.
+  void waitIdle();
+
+  /// Number of programs queued or being compiled.
+  size_t getNumQueued() const;
+
+private:
+  ShaderCompileService(const ShaderCompileService&) = delete;
+  ShaderCompileService& operator=(const ShaderCompileService&) = delete;
+
+  /// Copy of a ShaderSource that owns its data.
+  struct OwnedSource
+  {
+    GLenum                    shaderType;
+    std::string               text;
+    std::vector<char>         binary;
+    std::string               entryPoint;
+    std::vector<GLuint>       constantIndices;
+    std::vector<GLuint>       constantValues;
+  };
+
+  struct Job
+  {
+    Ticket                    ticket;
+    std::string               label;
+    std::vector<OwnedSource>  sources;
+  };
+
+  struct Finished
+  {
+    GLuint      program;
+    GLsync      fence;
+    std::string error;
+  };
+
+  void workerMain();
+
+  /// Fails every queued job with \p error. Must be called with mMutex held.
+  void failQueuedJobs(const std::string& error);
+
+  /// Checks the fence of \p finished. Must be called with mMutex held.
+  bool isSignaled(const Finished& finished) const;
+
+  std::unique_ptr<ShaderCompileContext> mContext;
+  std::thread                           mWorker;
+
+  mutable std::mutex                    mMutex;
+  std::condition_variable               mWorkAvailable;
+  std::condition_variable               mIdle;
+  std::deque<Job>                       mQueue;
+  std::map<Ticket, Finished>            mFinished;
+  Ticket                                mBuilding;    ///< 0 when the worker is idle.
+  Ticket                                mNextTicket;
+  bool                                  mStop;
+  std::string                           mContextError; ///< Set if the worker context failed.
+};
+
+} // namespace CPM_GL_SHADERS_NS
+
+#endif // GL_SYNC_GPU_COMMANDS_COMPLETE
+
+#endif
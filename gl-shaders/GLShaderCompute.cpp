@@ -0,0 +1,221 @@
+/// \date   October 2026
+
+#include <stdexcept>
+#include <algorithm>
+#include <map>
+#include <string>
+#include "GLShaderCompute.hpp"
+#include "GLDispatch.hpp"
+
+#ifdef GL_COMPUTE_SHADER
+
+namespace CPM_GL_SHADERS_NS {
+
+namespace {
+
+// Image types occupy a contiguous range of enums, from GL_IMAGE_1D (0x904C)
+// to GL_UNSIGNED_INT_IMAGE_2D_MULTISAMPLE_ARRAY (0x906C). Not all of them are
+// declared by OpenGL ES headers.
+const GLenum FIRST_IMAGE_TYPE = 0x904C;
+const GLenum LAST_IMAGE_TYPE  = 0x906C;
+
+GLint getNumResources(GLuint program, GLenum programInterface)
+{
+  GLint numResources = 0;
+  GLD(glDispatch().GetProgramInterfaceiv(program, programInterface, GL_ACTIVE_RESOURCES,
+                                         &numResources));
+  return numResources;
+}
+
+} // anonymous namespace
+
+ShaderStorageBlock::ShaderStorageBlock() :
+    blockIndex(0),
+    binding(0),
+    dataSize(0)
+{}
+
+ShaderStorageBlock::ShaderStorageBlock(const std::string& name, GLuint index,
+                                       GLint bindingPoint, GLint size) :
+    nameInCode(name),
+    blockIndex(index),
+    binding(bindingPoint),
+    dataSize(size)
+{}
+
+std::vector<ShaderStorageBlock> getProgramStorageBlocks(GLuint program)
+{
+  std::vector<ShaderStorageBlock> blocks;
+  GLint numBlocks = getNumResources(program, GL_SHADER_STORAGE_BLOCK);
+  if (numBlocks <= 0) return blocks;
+
+  GLint maxNameLength = 0;
+  GLD(glDispatch().GetProgramInterfaceiv(program, GL_SHADER_STORAGE_BLOCK,
+                                         GL_MAX_NAME_LENGTH, &maxNameLength));
+  std::vector<GLchar> name(static_cast<size_t>(std::max(maxNameLength, 1)));
+
+  std::map<GLint, std::string> bindings;
+  for (GLint i = 0; i < numBlocks; ++i)
+  {
+    GLuint index = static_cast<GLuint>(i);
+    name[0] = '\0';
+    GLD(glDispatch().GetProgramResourceName(program, GL_SHADER_STORAGE_BLOCK, index,
+                                            static_cast<GLsizei>(name.size()), NULL, &name[0]));
+
+    const GLenum props[] = {GL_BUFFER_BINDING, GL_BUFFER_DATA_SIZE};
+    GLint values[] = {0, 0};
+    GLD(glDispatch().GetProgramResourceiv(program, GL_SHADER_STORAGE_BLOCK, index,
+                                          2, props, 2, NULL, values));
+
+    ShaderStorageBlock block(&name[0], index, values[0], values[1]);
+    auto existing = bindings.find(block.binding);
+    if (existing != bindings.end())
+    {
+      std::cerr << "Storage blocks '" << existing->second << "' and '" << block.nameInCode
+                << "' share binding " << block.binding << "." << std::endl;
+    }
+    bindings[block.binding] = block.nameInCode;
+    blocks.push_back(block);
+  }
+
+  return blocks;
+}
+
+std::vector<ShaderImageUniform> getProgramImages(GLuint program)
+{
+  std::vector<ShaderImageUniform> images;
+  std::vector<ShaderUniform> uniforms = getProgramUniforms(program);
+  for (auto it = uniforms.begin(); it != uniforms.end(); ++it)
+  {
+    if (it->type < FIRST_IMAGE_TYPE || it->type > LAST_IMAGE_TYPE) continue;
+
+    ShaderImageUniform image;
+    image.nameInCode = it->nameInCode;
+    image.type       = it->type;
+    image.uniformLoc = it->uniformLoc;
+    image.size       = std::max(it->size, 1);
+    image.units.assign(static_cast<size_t>(image.size), 0);
+
+    // Array elements are looked up by name; their locations need not be
+    // consecutive.
+    std::string baseName = it->nameInCode;
+    size_t bracket = baseName.rfind('[');
+    if (bracket != std::string::npos) baseName.erase(bracket);
+    for (GLint element = 0; element < image.size; ++element)
+    {
+      GLint location = it->uniformLoc;
+      if (element > 0)
+      {
+        std::string name = baseName + "[" + std::to_string(element) + "]";
+        location = glDispatch().GetUniformLocation(program, name.c_str());
+        GLD_CHECK();
+      }
+      if (location >= 0)
+      {
+        GLD(glDispatch().GetUniformiv(program, location, &image.units[static_cast<size_t>(element)]));
+      }
+    }
+    image.unit = image.units[0];
+    images.push_back(image);
+  }
+  return images;
+}
+
+std::vector<AtomicCounterBuffer> getProgramAtomicCounters(GLuint program)
+{
+  std::vector<AtomicCounterBuffer> buffers;
+  GLint numBuffers = getNumResources(program, GL_ATOMIC_COUNTER_BUFFER);
+  for (GLint i = 0; i < numBuffers; ++i)
+  {
+    const GLenum props[] = {GL_BUFFER_BINDING, GL_BUFFER_DATA_SIZE, GL_NUM_ACTIVE_VARIABLES};
+    GLint values[] = {0, 0, 0};
+    GLD(glDispatch().GetProgramResourceiv(program, GL_ATOMIC_COUNTER_BUFFER,
+                                          static_cast<GLuint>(i), 3, props, 3, NULL, values));
+
+    AtomicCounterBuffer buffer;
+    buffer.index       = static_cast<GLuint>(i);
+    buffer.binding     = values[0];
+    buffer.dataSize    = values[1];
+    buffer.numCounters = values[2];
+    buffers.push_back(buffer);
+  }
+  return buffers;
+}
+
+ComputeProgramInfo getComputeProgramInfo(GLuint program)
+{
+  ComputeProgramInfo info;
+  info.workGroupSize[0] = info.workGroupSize[1] = info.workGroupSize[2] = 0;
+  GLD(glDispatch().GetProgramiv(program, GL_COMPUTE_WORK_GROUP_SIZE, info.workGroupSize));
+  if (info.workGroupSize[0] <= 0 || info.workGroupSize[1] <= 0 || info.workGroupSize[2] <= 0)
+  {
+    std::cerr << "getComputeProgramInfo: program " << program
+              << " does not have a compute stage." << std::endl;
+    throw std::runtime_error("Program has no compute stage.");
+  }
+
+  info.storageBlocks  = getProgramStorageBlocks(program);
+  info.images         = getProgramImages(program);
+  info.atomicCounters = getProgramAtomicCounters(program);
+  return info;
+}
+
+int hasStorageBlock(const ShaderStorageBlock* array, size_t size, const std::string& name)
+{
+  for (size_t i = 0; i < size; ++i)
+  {
+    if (array[i].nameInCode == name)
+      return static_cast<int>(i);
+  }
+  return -1;
+}
+
+void getComputeGroupCount(const GLint workGroupSize[3], const GLuint problemSize[3],
+                          GLuint groupCount[3])
+{
+  for (int i = 0; i < 3; ++i)
+  {
+    // Rounding up with 'problemSize + localSize - 1' overflows near UINT_MAX.
+    GLuint localSize = static_cast<GLuint>(workGroupSize[i]);
+    groupCount[i] = problemSize[i] / localSize + (problemSize[i] % localSize != 0 ? 1 : 0);
+  }
+}
+
+void bindStorageBlock(const ComputeProgramInfo& info, const std::string& blockName,
+                      GLuint buffer)
+{
+  int index = hasStorageBlock(info.storageBlocks.data(), info.storageBlocks.size(), blockName);
+  if (index < 0)
+  {
+    std::cerr << "bindStorageBlock: program has no storage block named '"
+              << blockName << "'." << std::endl;
+    throw std::runtime_error("Unknown storage block.");
+  }
+  GLD(glDispatch().BindBufferBase(GL_SHADER_STORAGE_BUFFER,
+                                  static_cast<GLuint>(info.storageBlocks[index].binding),
+                                  buffer));
+}
+
+void dispatchCompute(GLuint program, const ComputeProgramInfo& info,
+                     const std::vector<ComputeBufferBinding>& buffers,
+                     GLuint sizeX, GLuint sizeY, GLuint sizeZ)
+{
+  GLD(glDispatch().UseProgram(program));
+  for (auto it = buffers.begin(); it != buffers.end(); ++it)
+  {
+    bindStorageBlock(info, it->blockName, it->buffer);
+  }
+
+  const GLuint problemSize[3] = {sizeX, sizeY, sizeZ};
+  GLuint groupCount[3];
+  getComputeGroupCount(info.workGroupSize, problemSize, groupCount);
+  if (groupCount[0] == 0 || groupCount[1] == 0 || groupCount[2] == 0)
+  {
+    return;
+  }
+  GLD(glDispatch().DispatchCompute(groupCount[0], groupCount[1], groupCount[2]));
+}
+
+} // namespace CPM_GL_SHADERS_NS
+
+#endif // GL_COMPUTE_SHADER
@@ -0,0 +1,109 @@
+/// \date   October 2026
+
+#ifndef IAUNS_GLSHADERCOMPUTE_HPP
+#define IAUNS_GLSHADERCOMPUTE_HPP
+
+#include <vector>
+#include <string>
+#include <gl-platform/GLPlatform.hpp>
+
+#include "GLShader.hpp"
+
+// Compute shaders require OpenGL 4.3 or OpenGL ES 3.1.
+#ifdef GL_COMPUTE_SHADER
+
+namespace CPM_GL_SHADERS_NS {
+
+/// Shader storage block, as reported by the program interface query.
+struct ShaderStorageBlock
+{
+  ShaderStorageBlock();
+  ShaderStorageBlock(const std::string& name, GLuint index, GLint binding,
+                     GLint dataSize);
+
+  std::string nameInCode;   ///< Block name (not the instance name).
+  GLuint      blockIndex;   ///< Index of the block in the program.
+  GLint       binding;      ///< Buffer binding point. Set with layout(binding = N).
+  GLint       dataSize;     ///< Minimum buffer size, in bytes. Runtime-sized
+                            ///< arrays contribute a single element.
+};
+
+/// Image uniform and the image units it reads from.
+struct ShaderImageUniform
+{
+  std::string         nameInCode;
+  GLenum              type;         ///< GL type, e.g. GL_IMAGE_2D.
+  GLint               uniformLoc;
+  GLint               size;         ///< Array size, 1 for non-array images.
+  GLint               unit;         ///< Image unit of the first element. Set with layout(binding = N).
+  std::vector<GLint>  units;        ///< Image unit of every array element.
+};
+
+/// Atomic counter buffer binding used by a program.
+struct AtomicCounterBuffer
+{
+  GLuint  index;            ///< Index of the buffer in the program.
+  GLint   binding;          ///< Buffer binding point.
+  GLint   dataSize;         ///< Minimum buffer size, in bytes.
+  GLint   numCounters;      ///< Number of atomic counters in the buffer.
+};
+
+/// Everything needed to run a compute program.
+struct ComputeProgramInfo
+{
+  GLint                             workGroupSize[3];   ///< Local size x, y, z.
+  std::vector<ShaderStorageBlock>   storageBlocks;
+  std::vector<ShaderImageUniform>   images;
+  std::vector<AtomicCounterBuffer>  atomicCounters;
+};
+
+/// Collects the shader storage blocks of \p program. Warns (std::cerr) when
+/// two blocks share a binding point, which usually means a missing
+/// layout(binding = N) qualifier.
+std::vector<ShaderStorageBlock> getProgramStorageBlocks(GLuint program);
+
+/// Collects the image uniforms of \p program and the image unit of every
+/// element of image arrays.
+std::vector<ShaderImageUniform> getProgramImages(GLuint program);
+
+/// Collects the atomic counter buffers used by \p program.
+std::vector<AtomicCounterBuffer> getProgramAtomicCounters(GLuint program);
+
+/// Collects the local work-group size and all of the above. Throws a runtime
+/// exception if \p program has no compute stage.
+ComputeProgramInfo getComputeProgramInfo(GLuint program);
+
+/// Determines if the given storage block array has the block with 'name'.
+/// \return -1 if no block exists, otherwise the index of the block.
+int hasStorageBlock(const ShaderStorageBlock* array, size_t size, const std::string& name);
+
+/// Number of work groups needed to cover \p problemSize invocations along
+/// each axis, i.e. problemSize rounded up to a multiple of the local size.
+/// Shaders must discard invocations past the end of the problem.
+void getComputeGroupCount(const GLint workGroupSize[3], const GLuint problemSize[3],
+                          GLuint groupCount[3]);
+
+/// Buffer to bind to a storage block for a dispatch.
+struct ComputeBufferBinding
+{
+  std::string blockName;    ///< Name of the storage block in code.
+  GLuint      buffer;
+};
+
+/// Binds \p buffer to the binding point of the storage block named
+/// \p blockName. Throws a runtime exception if the program has no such block.
+void bindStorageBlock(const ComputeProgramInfo& info, const std::string& blockName,
+                      GLuint buffer);
+
+/// Binds \p program and \p buffers, then dispatches enough work groups to
+/// cover sizeX * sizeY * sizeZ invocations. Memory barriers required by
+/// consumers of the results (glMemoryBarrier) are left to the caller.
+void dispatchCompute(GLuint program, const ComputeProgramInfo& info,
+                     const std::vector<ComputeBufferBinding>& buffers,
+                     GLuint sizeX, GLuint sizeY = 1, GLuint sizeZ = 1);
+
+} // namespace CPM_GL_SHADERS_NS
+
+#endif // GL_COMPUTE_SHADER
+
+#endif
@@ -0,0 +1,176 @@
+/// \date   October 2026
+
+#include <stdexcept>
+#include <algorithm>
+#include "GLShaderPipeline.hpp"
+#include "GLDispatch.hpp"
+
+#ifdef GL_PROGRAM_SEPARABLE
+
+namespace CPM_GL_SHADERS_NS {
+
+SeparableStage loadSeparableStage(const ShaderSource& shader)
+{
+  GLuint program = glDispatch().CreateProgram();
+  GLD_CHECK();
+  if (0 == program)
+  {
+    // This usually indicates an invalid context.
+    throw std::runtime_error("Unable to create GL program using glCreateProgram.");
+  }
+  GLD(glDispatch().ProgramParameteri(program, GL_PROGRAM_SEPARABLE, GL_TRUE));
+
+  GLuint shaderID = 0;
+  try
+  {
+    shaderID = compileShader(shader);
+    GLD(glDispatch().AttachShader(program, shaderID));
+    linkProgram(program);
+  }
+  catch (...)
+  {
+    if (shaderID != 0) GLD(glDispatch().DeleteShader(shaderID));
+    GLD(glDispatch().DeleteProgram(program));
+    throw;
+  }
+
+  GLD(glDispatch().DetachShader(program, shaderID));
+  GLD(glDispatch().DeleteShader(shaderID));
+
+  SeparableStage stage;
+  stage.program    = program;
+  stage.shaderType = shader.mShaderType;
+  stage.uniforms   = getProgramUniforms(program);
+  if (shader.mShaderType == GL_VERTEX_SHADER)
+  {
+    stage.attributes = getProgramAttributes(program);
+    sortAttributesAlphabetically(stage.attributes);
+  }
+  return stage;
+}
+
+void deleteSeparableStage(SeparableStage& stage)
+{
+  GLD(glDispatch().DeleteProgram(stage.program));
+  stage = SeparableStage();
+}
+
+GLbitfield getShaderStageBit(GLenum shaderType)
+{
+  switch (shaderType)
+  {
+    case GL_VERTEX_SHADER:          return GL_VERTEX_SHADER_BIT;
+    case GL_FRAGMENT_SHADER:        return GL_FRAGMENT_SHADER_BIT;
+#ifdef GL_GEOMETRY_SHADER_BIT
+    case GL_GEOMETRY_SHADER:        return GL_GEOMETRY_SHADER_BIT;
+#endif
+#ifdef GL_TESS_CONTROL_SHADER_BIT
+    case GL_TESS_CONTROL_SHADER:    return GL_TESS_CONTROL_SHADER_BIT;
+    case GL_TESS_EVALUATION_SHADER: return GL_TESS_EVALUATION_SHADER_BIT;
+#endif
+#ifdef GL_COMPUTE_SHADER_BIT
+    case GL_COMPUTE_SHADER:         return GL_COMPUTE_SHADER_BIT;
+#endif
+    default:
+      std::cerr << "getShaderStageBit: unrecognized shader type: " << shaderType << std::endl;
+      throw std::runtime_error("Unrecognized shader type.");
+  }
+}
+
+GLuint createProgramPipeline(const SeparableStage* stages, size_t size)
+{
+  GLuint pipeline = 0;
+  GLD(glDispatch().GenProgramPipelines(1, &pipeline));
+  if (0 == pipeline)
+  {
+    throw std::runtime_error("Unable to create program pipeline using glGenProgramPipelines.");
+  }
+
+  GLbitfield usedStages = 0;
+  for (size_t i = 0; i < size; ++i)
+  {
+    GLbitfield bit = getShaderStageBit(stages[i].shaderType);
+    if (usedStages & bit)
+    {
+      GLD(glDispatch().DeleteProgramPipelines(1, &pipeline));
+      throw std::runtime_error("createProgramPipeline: Duplicate shader stage.");
+    }
+    usedStages |= bit;
+    GLD(glDispatch().UseProgramStages(pipeline, bit, stages[i].program));
+  }
+
+  return pipeline;
+}
+
+bool validateProgramPipeline(GLuint pipeline)
+{
+  GLD(glDispatch().ValidateProgramPipeline(pipeline));
+
+  GLint valid;
+  GLD(glDispatch().GetProgramPipelineiv(pipeline, GL_VALIDATE_STATUS, &valid));
+  if (!valid)
+  {
+    GLint infoLen = 0;
+    GLD(glDispatch().GetProgramPipelineiv(pipeline, GL_INFO_LOG_LENGTH, &infoLen));
+    if (infoLen > 1)
+    {
+      char* infoLog = new char[infoLen];
+
+      GLD(glDispatch().GetProgramPipelineInfoLog(pipeline, infoLen, NULL, infoLog));
+      std::cerr << "Error validating program pipeline:" << std::endl;
+      std::cerr << infoLog << std::endl;
+
+      delete[] infoLog;
+    }
+    return false;
+  }
+  return true;
+}
+
+ProgramPipelineCache::~ProgramPipelineCache()
+{
+  for (auto it = mPipelines.begin(); it != mPipelines.end(); ++it)
+  {
+    GLD(glDispatch().DeleteProgramPipelines(1, &it->second));
+  }
+}
+
+GLuint ProgramPipelineCache::getPipeline(const SeparableStage* stages, size_t size)
+{
+  std::vector<GLuint> key;
+  for (size_t i = 0; i < size; ++i)
+  {
+    key.push_back(stages[i].program);
+  }
+  std::sort(key.begin(), key.end());
+
+  auto it = mPipelines.find(key);
+  if (it != mPipelines.end())
+  {
+    return it->second;
+  }
+
+  GLuint pipeline = createProgramPipeline(stages, size);
+  mPipelines[key] = pipeline;
+  return pipeline;
+}
+
+void ProgramPipelineCache::removeStage(GLuint program)
+{
+  for (auto it = mPipelines.begin(); it != mPipelines.end();)
+  {
+    if (std::binary_search(it->first.begin(), it->first.end(), program))
+    {
+      GLD(glDispatch().DeleteProgramPipelines(1, &it->second));
+      it = mPipelines.erase(it);
+    }
+    else
+    {
+      ++it;
+    }
+  }
+}
+
+} // namespace CPM_GL_SHADERS_NS
+
+#endif // GL_PROGRAM_SEPARABLE
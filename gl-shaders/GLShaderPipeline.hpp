@@ -0,0 +1,82 @@
+/// \date   October 2026
+
+#ifndef IAUNS_GLSHADERPIPELINE_HPP
+#define IAUNS_GLSHADERPIPELINE_HPP
+
+// All functions below assume there is a valid OpenGL context active.
+#include <vector>
+#include <map>
+#include <gl-platform/GLPlatform.hpp>
+
+#include "GLShader.hpp"
+
+// Separable programs require OpenGL 4.1, ARB_separate_shader_objects, or
+// OpenGL ES 3.1.
+#ifdef GL_PROGRAM_SEPARABLE
+
+namespace CPM_GL_SHADERS_NS {
+
+/// A single shader stage linked into its own separable program. Stages are
+/// combined at draw time with a program pipeline object, so M vertex stages
+/// and N fragment stages require M + N compiles and links instead of M * N.
+struct SeparableStage
+{
+  SeparableStage() : program(0), shaderType(0) {}
+
+  GLuint                        program;    ///< Separable GL program.
+  GLenum                        shaderType; ///< Same as ShaderSource::mShaderType.
+  std::vector<ShaderAttribute>  attributes; ///< Only populated for vertex stages.
+  std::vector<ShaderUniform>    uniforms;   ///< Uniforms of this stage only.
+};
+
+/// Compiles and links \p shader into a separable program and reflects its
+/// attributes and uniforms. Throws a runtime exception on failure. Uniforms of
+/// separable programs must be set with glProgramUniform*, or after selecting
+/// the stage with glActiveShaderProgram.
+SeparableStage loadSeparableStage(const ShaderSource& shader);
+
+/// Deletes the stage's program and resets it.
+void deleteSeparableStage(SeparableStage& stage);
+
+/// Returns the glUseProgramStages bit (e.g. GL_VERTEX_SHADER_BIT) for a shader
+/// type. Throws a runtime exception for unknown types.
+GLbitfield getShaderStageBit(GLenum shaderType);
+
+/// Creates a program pipeline object using the given stages. Each stage must
+/// be of a different shader type.
+GLuint createProgramPipeline(const SeparableStage* stages, size_t size);
+
+/// Validates \p pipeline against the current GL state. Returns false, and
+/// writes the validation log to std::cerr, if the pipeline is not usable.
+bool validateProgramPipeline(GLuint pipeline);
+
+/// Creates program pipelines on demand and reuses them for identical stage
+/// combinations. Owns, and deletes, all pipelines it creates. Stage programs
+/// are not owned.
+class ProgramPipelineCache
+{
+public:
+  ProgramPipelineCache() {}
+  ~ProgramPipelineCache();
+
+  /// Retrieves (or creates) the pipeline combining the given stages.
+  GLuint getPipeline(const SeparableStage* stages, size_t size);
+
+  /// Deletes every pipeline that uses \p program. Call this before deleting a
+  /// stage's program.
+  void removeStage(GLuint program);
+
+  size_t getNumPipelines() const {return mPipelines.size();}
+
+private:
+  ProgramPipelineCache(const ProgramPipelineCache&) = delete;
+  ProgramPipelineCache& operator=(const ProgramPipelineCache&) = delete;
+
+  std::map<std::vector<GLuint>, GLuint> mPipelines; ///< Sorted stage programs -> pipeline.
+};
+
+} // namespace CPM_GL_SHADERS_NS
+
+#endif // GL_PROGRAM_SEPARABLE
+
+#endif
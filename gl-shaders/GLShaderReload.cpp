@@ -0,0 +1,498 @@
+/// \date   October 2026
+
+#include <stdexcept>
+#include <fstream>
+#include <sstream>
+#include <set>
+#include <sys/stat.h>
+
+#if defined(__linux__)
+  #include <sys/inotify.h>
+  #include <unistd.h>
+  #include <cerrno>
+#endif
+
+#include "GLShaderReload.hpp"
+#include "GLDispatch.hpp"
+
+namespace CPM_GL_SHADERS_NS {
+
+namespace {
+
+std::string getDirectory(const std::string& path)
+{
+  size_t slash = path.find_last_of('/');
+  if (slash == std::string::npos) return ".";
+  if (slash == 0)                 return "/";
+  return path.substr(0, slash);
+}
+
+std::string getFilename(const std::string& path)
+{
+  size_t slash = path.find_last_of('/');
+  if (slash == std::string::npos) return path;
+  return path.substr(slash + 1);
+}
+
+/// Paths are normalized to 'directory/filename' so they can be matched
+/// against the names reported by inotify for a watched directory.
+std::string normalizePath(const std::string& path)
+{
+  return getDirectory(path) + "/" + getFilename(path);
+}
+
+int64_t getModificationTime(const std::string& path)
+{
+  struct stat info;
+  if (stat(path.c_str(), &info) != 0)
+  {
+    return 0;
+  }
+  return static_cast<int64_t>(info.st_mtime);
+}
+
+std::string readStageSource(const std::vector<std::string>& files)
+{
+  std::string source;
+  for (auto it = files.begin(); it != files.end(); ++it)
+  {
+    std::ifstream in(it->c_str(), std::ios::in | std::ios::binary);
+    if (!in)
+    {
+      throw std::runtime_error("ShaderReloadService: Unable to read " + *it);
+    }
+    std::ostringstream contents;
+    contents << in.rdbuf();
+    source += contents.str();
+  }
+  return source;
+}
+
+} // anonymous namespace
+
+ShaderReloadService::ShaderReloadService(bool useNotify) :
+    mNotifyFD(-1)
+{
+#if defined(__linux__)
+  if (!useNotify) return;
+
+  mNotifyFD = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+  if (mNotifyFD < 0)
+  {
+    std::cerr << "ShaderReloadService: inotify unavailable, falling back to "
+              << "polling modification times." << std::endl;
+    mNotifyFD = -1;
+  }
+#endif
+}
+
+ShaderReloadService::~ShaderReloadService()
+{
+  for (auto it = mPrograms.begin(); it != mPrograms.end(); ++it)
+  {
+    GLD(glDispatch().DeleteProgram((*it)->state.program));
+  }
+  for (auto it = mStages.begin(); it != mStages.end(); ++it)
+  {
+    GLD(glDispatch().DeleteShader(it->shader));
+    discardCandidate(*it);
+  }
+
+#if defined(__linux__)
+  if (mNotifyFD >= 0)
+  {
+    close(mNotifyFD);
+  }
+#endif
+}
+
+ShaderReloadService::ProgramID ShaderReloadService::addProgram(
+    const std::vector<ReloadableStage>& stages)
+{
+  std::unique_ptr<ProgramEntry> entry(new ProgramEntry);
+  size_t firstNewStage = mStages.size();
+  GLuint program = 0;
+  try
+  {
+    for (auto it = stages.begin(); it != stages.end(); ++it)
+    {
+      entry->stages.push_back(acquireStage(*it));
+    }
+
+    if (!buildProgram(*entry, program, entry->linkedHashes))
+    {
+      throw std::runtime_error("ShaderReloadService: Failed to build program.");
+    }
+  }
+  catch (...)
+  {
+    // Stages created by this call have no owning program.
+    releaseStages(firstNewStage);
+    throw;
+  }
+
+  entry->state.program    = program;
+  entry->state.attributes = getProgramAttributes(program);
+  entry->state.uniforms   = getProgramUniforms(program);
+  sortAttributesAlphabetically(entry->state.attributes);
+
+  ProgramID id = mPrograms.size();
+  for (auto it = entry->stages.begin(); it != entry->stages.end(); ++it)
+  {
+    mStages[*it].programs.push_back(id);
+  }
+  mPrograms.push_back(std::move(entry));
+  return id;
+}
+
+const ShaderReloadService::Program& ShaderReloadService::getProgram(ProgramID id) const
+{
+  if (id >= mPrograms.size())
+  {
+    throw std::runtime_error("ShaderReloadService: Invalid program ID.");
+  }
+  return mPrograms[id]->state;
+}
+
+size_t ShaderReloadService::poll()
+{
+  collectChangedFiles();
+  for (auto stage = mStages.begin(); stage != mStages.end(); ++stage)
+  {
+    for (auto file = stage->files.begin(); file != stage->files.end(); ++file)
+    {
+      stage->dirty = stage->dirty || mFiles[normalizePath(*file)].dirty;
+    }
+  }
+  for (auto it = mFiles.begin(); it != mFiles.end(); ++it)
+  {
+    it->second.dirty = false;
+  }
+
+  // Compile a candidate for every dirty stage whose source actually changed.
+  // Saving a file without modifying it, or touching one file of a multi-file
+  // stage, does not trigger a recompile. Candidates are kept across polls
+  // until every program using the stage has been relinked with them.
+  std::set<ProgramID> affected;
+  for (size_t index = 0; index < mStages.size(); ++index)
+  {
+    Stage& stage = mStages[index];
+    if (!stage.dirty) continue;
+
+    try
+    {
+      std::string source = readStageSource(stage.files);
+      ShaderSource shaderSource({source.c_str()}, stage.shaderType);
+      uint64_t hash = hashShaderSource(shaderSource);
+      if (hash == stage.hash)
+      {
+        // Back to the committed version. Programs that were already relinked
+        // with the discarded candidate are relinked again.
+        discardCandidate(stage);
+        stage.dirty = false;
+        for (auto id = stage.programs.begin(); id != stage.programs.end(); ++id)
+        {
+          if (getLinkedHash(*mPrograms[*id], index) != hash) affected.insert(*id);
+        }
+        continue;
+      }
+
+      // Already compiled, or failed to compile, in an earlier poll.
+      if (hash == stage.candidateHash) continue;
+
+      discardCandidate(stage);
+      stage.candidateHash = hash;
+      stage.candidate     = compileShader(shaderSource);
+      affected.insert(stage.programs.begin(), stage.programs.end());
+    }
+    catch (const std::exception& e)
+    {
+      std::cerr << "ShaderReloadService: Keeping previous version of stage '"
+                << stage.files.back() << "': " << e.what() << std::endl;
+    }
+  }
+
+  // Relink affected programs. The old program stays in place until its
+  // replacement has linked successfully.
+  size_t numSwapped = 0;
+  for (auto id = affected.begin(); id != affected.end(); ++id)
+  {
+    ProgramEntry& entry = *mPrograms[*id];
+    GLuint program = 0;
+    std::vector<uint64_t> hashes;
+    if (!buildProgram(entry, program, hashes))
+    {
+      std::cerr << "ShaderReloadService: Keeping previous version of program "
+                << *id << "." << std::endl;
+      continue;
+    }
+
+    GLuint oldProgram = entry.state.program;
+    entry.state.program    = program;
+    entry.state.attributes = getProgramAttributes(program);
+    entry.state.uniforms   = getProgramUniforms(program);
+    sortAttributesAlphabetically(entry.state.attributes);
+    ++entry.state.generation;
+    entry.linkedHashes = hashes;
+    GLD(glDispatch().DeleteProgram(oldProgram));
+    ++numSwapped;
+
+    if (mCallback)
+    {
+      mCallback(*id, oldProgram, program);
+    }
+  }
+
+  // Commit candidates once every program using the stage links with them.
+  // Otherwise the stage stays dirty, and a failed relink is retried when any
+  // stage of the program changes (e.g. after fixing the other side of an
+  // interface mismatch).
+  for (size_t index = 0; index < mStages.size(); ++index)
+  {
+    Stage& stage = mStages[index];
+    if (stage.candidate == 0) continue;
+
+    bool linked = true;
+    for (auto id = stage.programs.begin(); id != stage.programs.end(); ++id)
+    {
+      linked = linked && getLinkedHash(*mPrograms[*id], index) == stage.candidateHash;
+    }
+    if (!linked) continue;
+
+    // Programs that are already linked do not need the old shader object.
+    GLD(glDispatch().DeleteShader(stage.shader));
+    stage.shader        = stage.candidate;
+    stage.hash          = stage.candidateHash;
+    stage.candidate     = 0;
+    stage.candidateHash = 0;
+    stage.dirty         = false;
+  }
+
+  return numSwapped;
+}
+
+void ShaderReloadService::discardCandidate(Stage& stage)
+{
+  if (stage.candidate != 0)
+  {
+    GLD(glDispatch().DeleteShader(stage.candidate));
+  }
+  stage.candidate     = 0;
+  stage.candidateHash = 0;
+}
+
+uint64_t ShaderReloadService::getLinkedHash(const ProgramEntry& entry, size_t stage)
+{
+  for (size_t i = 0; i < entry.stages.size(); ++i)
+  {
+    if (entry.stages[i] == stage) return entry.linkedHashes[i];
+  }
+  return 0;
+}
+
+size_t ShaderReloadService::acquireStage(const ReloadableStage& stage)
+{
+  std::ostringstream key;
+  key << stage.mShaderType;
+  for (auto it = stage.mFiles.begin(); it != stage.mFiles.end(); ++it)
+  {
+    key << "|" << normalizePath(*it);
+  }
+
+  auto existing = mStageIndex.find(key.str());
+  if (existing != mStageIndex.end())
+  {
+    return existing->second;
+  }
+
+  std::string source = readStageSource(stage.mFiles);
+  ShaderSource shaderSource({source.c_str()}, stage.mShaderType);
+
+  Stage newStage;
+  newStage.shaderType = stage.mShaderType;
+  newStage.files      = stage.mFiles;
+  newStage.shader     = compileShader(shaderSource);
+  newStage.hash       = hashShaderSource(shaderSource);
+
+  for (auto it = stage.mFiles.begin(); it != stage.mFiles.end(); ++it)
+  {
+    watchFile(*it);
+  }
+
+  mStageIndex[key.str()] = mStages.size();
+  mStages.push_back(newStage);
+  return mStages.size() - 1;
+}
+
+void ShaderReloadService::releaseStages(size_t first)
+{
+  for (size_t i = first; i < mStages.size(); ++i)
+  {
+    GLD(glDispatch().DeleteShader(mStages[i].shader));
+  }
+  mStages.resize(first);
+
+  for (auto it = mStageIndex.begin(); it != mStageIndex.end();)
+  {
+    if (it->second >= first) it = mStageIndex.erase(it);
+    else                     ++it;
+  }
+
+  // Stop watching files, and directories, no remaining stage reads from.
+  std::set<std::string> files;
+  std::set<std::string> directories;
+  for (auto stage = mStages.begin(); stage != mStages.end(); ++stage)
+  {
+    for (auto file = stage->files.begin(); file != stage->files.end(); ++file)
+    {
+      files.insert(normalizePath(*file));
+      directories.insert(getDirectory(*file));
+    }
+  }
+
+  for (auto it = mFiles.begin(); it != mFiles.end();)
+  {
+    if (files.find(it->first) == files.end()) it = mFiles.erase(it);
+    else                                      ++it;
+  }
+
+#if defined(__linux__)
+  for (auto it = mWatchDirs.begin(); it != mWatchDirs.end();)
+  {
+    if (directories.find(it->second) == directories.end())
+    {
+      inotify_rm_watch(mNotifyFD, it->first);
+      it = mWatchDirs.erase(it);
+    }
+    else
+    {
+      ++it;
+    }
+  }
+#endif
+}
+
+void ShaderReloadService::watchFile(const std::string& path)
+{
+  std::string normalized = normalizePath(path);
+  if (mFiles.find(normalized) != mFiles.end())
+  {
+    return;
+  }
+
+  WatchedFile file;
+  file.mtime = getModificationTime(path);
+  mFiles[normalized] = file;
+
+#if defined(__linux__)
+  if (mNotifyFD >= 0)
+  {
+    // Watch the directory rather than the file. Most editors save by writing
+    // a temporary file and renaming it over the original, which would
+    // silently drop a watch placed on the file itself.
+    std::string directory = getDirectory(path);
+    for (auto it = mWatchDirs.begin(); it != mWatchDirs.end(); ++it)
+    {
+      if (it->second == directory) return;
+    }
+
+    int wd = inotify_add_watch(mNotifyFD, directory.c_str(),
+                               IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE);
+    if (wd < 0)
+    {
+      std::cerr << "ShaderReloadService: Unable to watch " << directory << std::endl;
+      return;
+    }
+    mWatchDirs[wd] = directory;
+  }
+#endif
+}
+
+void ShaderReloadService::collectChangedFiles()
+{
+#if defined(__linux__)
+  if (mNotifyFD >= 0)
+  {
+    alignas(struct inotify_event) char buffer[4096];
+    for (;;)
+    {
+      ssize_t length = read(mNotifyFD, buffer, sizeof(buffer));
+      if (length <= 0)
+      {
+        // EAGAIN: no more pending events.
+        break;
+      }
+
+      for (char* ptr = buffer; ptr < buffer + length;)
+      {
+        const struct inotify_event* event = reinterpret_cast<const struct inotify_event*>(ptr);
+        ptr += sizeof(struct inotify_event) + event->len;
+
+        auto dir = mWatchDirs.find(event->wd);
+        if (event->len == 0 || dir == mWatchDirs.end()) continue;
+
+        auto file = mFiles.find(dir->second + "/" + event->name);
+        if (file != mFiles.end())
+        {
+          file->second.dirty = true;
+        }
+      }
+    }
+    return;
+  }
+#endif
+
+  for (auto it = mFiles.begin(); it != mFiles.end(); ++it)
+  {
+    int64_t mtime = getModificationTime(it->first);
+    if (mtime != it->second.mtime)
+    {
+      it->second.mtime = mtime;
+      it->second.dirty = true;
+    }
+  }
+}
+
+bool ShaderReloadService::buildProgram(const ProgramEntry& entry, GLuint& programOut,
+                                       std::vector<uint64_t>& hashesOut)
+{
+  GLuint program = glDispatch().CreateProgram();
+  GLD_CHECK();
+  if (0 == program)
+  {
+    std::cerr << "ShaderReloadService: glCreateProgram failed." << std::endl;
+    return false;
+  }
+
+  // Stages with a compiled candidate are linked with it.
+  std::vector<GLuint> shaders;
+  hashesOut.clear();
+  for (auto it = entry.stages.begin(); it != entry.stages.end(); ++it)
+  {
+    const Stage& stage = mStages[*it];
+    shaders.push_back(stage.candidate != 0 ? stage.candidate : stage.shader);
+    hashesOut.push_back(stage.candidate != 0 ? stage.candidateHash : stage.hash);
+    GLD(glDispatch().AttachShader(program, shaders.back()));
+  }
+
+  try
+  {
+    linkProgram(program);
+  }
+  catch (const std::exception&)
+  {
+    GLD(glDispatch().DeleteProgram(program));
+    return false;
+  }
+
+  // Detach so shader objects can be deleted independently of this program.
+  for (auto it = shaders.begin(); it != shaders.end(); ++it)
+  {
+    GLD(glDispatch().DetachShader(program, *it));
+  }
+
+  programOut = program;
+  return true;
+}
+
+} // namespace CPM_GL_SHADERS_NS
@@ -0,0 +1,149 @@
+/// \date   October 2026
+
+#ifndef IAUNS_GLSHADERRELOAD_HPP
+#define IAUNS_GLSHADERRELOAD_HPP
+
+// All functions below assume there is a valid OpenGL context active.
+#include <vector>
+#include <string>
+#include <map>
+#include <functional>
+#include <memory>
+#include <cstdint>
+#include <gl-platform/GLPlatform.hpp>
+
+#include "GLShader.hpp"
+
+namespace CPM_GL_SHADERS_NS {
+
+/// A shader stage whose source is read from disk. The contents of all files
+/// are concatenated in order, in the same way as ShaderSource::mSources.
+struct ReloadableStage
+{
+  ReloadableStage(const std::vector<std::string>& files, GLenum shaderType) :
+      mFiles(files),
+      mShaderType(shaderType)
+  {}
+
+  std::vector<std::string>  mFiles;
+  GLenum                    mShaderType;
+};
+
+/// Watches shader source files and rebuilds programs when they change. On
+/// Linux changes are detected with inotify; elsewhere, or when inotify is
+/// disabled, file modification times are compared on every poll.
+///
+/// Only stages whose source hash changed are recompiled. Stages that are
+/// shared between programs (same type and files) are compiled once. Each
+/// affected program is relinked into a new program object: if compilation or
+/// linking fails the old program is kept, otherwise the old program is deleted
+/// and the new one takes its place, along with freshly reflected attributes
+/// and uniforms. Unaffected programs are left untouched.
+///
+/// A changed stage is only committed once every program using it has
+/// relinked. Until then it stays pending, so a program whose relink failed is
+/// retried as soon as any of its stages changes again, e.g. after fixing the
+/// other side of an interface mismatch.
+class ShaderReloadService
+{
+public:
+  typedef size_t ProgramID;
+
+  struct Program
+  {
+    Program() : program(0), generation(0) {}
+
+    GLuint                        program;    ///< Current GL program.
+    std::vector<ShaderAttribute>  attributes; ///< getProgramAttributes, sorted alphabetically.
+    std::vector<ShaderUniform>    uniforms;   ///< getProgramUniforms.
+    uint32_t                      generation; ///< Incremented on every successful reload.
+  };
+
+  /// Called after a program has been swapped. \p oldProgram has already been
+  /// deleted and is only provided for bookkeeping.
+  typedef std::function<void (ProgramID id, GLuint oldProgram, GLuint newProgram)> ReloadCallback;
+
+  /// When \p useNotify is false file modification times are polled even if
+  /// inotify is available.
+  explicit ShaderReloadService(bool useNotify = true);
+
+  /// True if changes are detected with inotify rather than by polling
+  /// modification times.
+  bool isUsingNotify() const {return mNotifyFD >= 0;}
+
+  /// Deletes all programs and shader objects owned by the service.
+  ~ShaderReloadService();
+
+  /// Loads, compiles, and links a program from the given stages and begins
+  /// watching their files. Throws a runtime exception if the files can not be
+  /// read or the program fails to build; stages first acquired by the failed
+  /// call are released along with their file watches.
+  ProgramID addProgram(const std::vector<ReloadableStage>& stages);
+
+  /// Retrieves the current state of a program. The reference stays valid for
+  /// the lifetime of the service.
+  const Program& getProgram(ProgramID id) const;
+
+  /// Called whenever a program is successfully reloaded.
+  void setReloadCallback(const ReloadCallback& callback) {mCallback = callback;}
+
+  /// Checks for modified files and rebuilds affected programs. Never blocks.
+  /// Returns the number of programs that were swapped.
+  size_t poll();
+
+private:
+  ShaderReloadService(const ShaderReloadService&) = delete;
+  ShaderReloadService& operator=(const ShaderReloadService&) = delete;
+
+  struct WatchedFile
+  {
+    WatchedFile() : mtime(0), dirty(false) {}
+
+    int64_t mtime;    ///< Used when inotify is unavailable.
+    bool    dirty;
+  };
+
+  struct Stage
+  {
+    Stage() : shaderType(0), shader(0), hash(0), candidate(0), candidateHash(0), dirty(false) {}
+
+    GLenum                    shaderType;
+    std::vector<std::string>  files;
+    GLuint                    shader;         ///< Committed shader object.
+    uint64_t                  hash;           ///< hashShaderSource of the committed source.
+    GLuint                    candidate;      ///< Changed source not yet linked by every program, or 0.
+    uint64_t                  candidateHash;  ///< Hash of the candidate, including one that failed to compile.
+    bool                      dirty;          ///< Files changed since the stage was last committed.
+    std::vector<ProgramID>    programs;       ///< Programs this stage is attached to.
+  };
+
+  struct ProgramEntry
+  {
+    Program               state;
+    std::vector<size_t>   stages;       ///< Indices into mStages.
+    std::vector<uint64_t> linkedHashes; ///< Hash of each stage in the current program.
+  };
+
+  size_t  acquireStage(const ReloadableStage& stage);
+  void    releaseStages(size_t first);
+  void    watchFile(const std::string& path);
+  void    collectChangedFiles();
+  bool    buildProgram(const ProgramEntry& entry, GLuint& programOut,
+                       std::vector<uint64_t>& hashesOut);
+  void    discardCandidate(Stage& stage);
+
+  static uint64_t getLinkedHash(const ProgramEntry& entry, size_t stage);
+
+  std::map<std::string, WatchedFile>  mFiles;       ///< Keyed by normalized path.
+  std::map<std::string, size_t>       mStageIndex;  ///< Stage key -> mStages index.
+  std::vector<Stage>                  mStages;
+  std::vector<std::unique_ptr<ProgramEntry>> mPrograms; ///< Pointers keep references stable.
+  ReloadCallback                      mCallback;
+
+  int                                 mNotifyFD;    ///< -1 when inotify is unavailable.
+  std::map<int, std::string>          mWatchDirs;   ///< inotify watch descriptor -> directory.
+};
+
+} // namespace CPM_GL_SHADERS_NS
+
+#endif
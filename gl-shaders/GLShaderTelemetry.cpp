@@ -0,0 +1,188 @@
+/// \date   October 2026
+
+#include <algorithm>
+#include <atomic>
+#include <ostream>
+#include <sstream>
+#include <iomanip>
+#include "GLShaderTelemetry.hpp"
+
+namespace CPM_GL_SHADERS_NS {
+
+namespace {
+
+std::atomic<ShaderTelemetry*> sTelemetry(nullptr);
+
+double getTotalSeconds(const ProgramTelemetry& program)
+{
+  return program.compileSeconds + program.linkSeconds;
+}
+
+void writeJSONString(std::ostream& out, const std::string& str)
+{
+  out << '"';
+  for (std::string::const_iterator it = str.begin(); it != str.end(); ++it)
+  {
+    unsigned char c = static_cast<unsigned char>(*it);
+    switch (c)
+    {
+      case '"':  out << "\\\""; break;
+      case '\\': out << "\\\\"; break;
+      case '\n': out << "\\n";  break;
+      case '\r': out << "\\r";  break;
+      case '\t': out << "\\t";  break;
+      default:
+        if (c < 0x20)
+        {
+          out << "\\u" << std::hex << std::setw(4) << std::setfill('0')
+              << static_cast<int>(c) << std::dec << std::setfill(' ');
+        }
+        else
+        {
+          out << *it;
+        }
+    }
+  }
+  out << '"';
+}
+
+void writeProgramJSON(std::ostream& out, const ProgramTelemetry& program)
+{
+  out << "{\"name\": ";
+  writeJSONString(out, program.getName());
+  out << ", \"program\": " << program.program
+      << ", \"success\": " << (program.success ? "true" : "false")
+      << ", \"compile_seconds\": " << program.compileSeconds
+      << ", \"link_seconds\": " << program.linkSeconds
+      << ", \"binary_bytes\": " << program.binaryBytes
+      << ", \"link_log\": ";
+  writeJSONString(out, program.linkLog);
+  out << ", \"stages\": [";
+  for (size_t i = 0; i < program.stages.size(); ++i)
+  {
+    const ShaderStageTelemetry& stage = program.stages[i];
+    out << (i ? ", " : "")
+        << "{\"type\": " << stage.shaderType
+        << ", \"source_bytes\": " << stage.sourceBytes
+        << ", \"compile_seconds\": " << stage.compileSeconds
+        << ", \"success\": " << (stage.success ? "true" : "false")
+        << ", \"log\": ";
+    writeJSONString(out, stage.log);
+    out << "}";
+  }
+  out << "]}";
+}
+
+} // anonymous namespace
+
+std::string ProgramTelemetry::getName() const
+{
+  if (!label.empty())
+  {
+    return label;
+  }
+
+  std::ostringstream name;
+  name << std::hex << std::setw(16) << std::setfill('0') << sourceHash;
+  return name.str();
+}
+
+void ShaderTelemetry::record(const ProgramTelemetry& program)
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  mPrograms.push_back(program);
+}
+
+std::vector<ProgramTelemetry> ShaderTelemetry::getPrograms() const
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  return mPrograms;
+}
+
+std::vector<ProgramTelemetry> ShaderTelemetry::getSlowest(size_t n) const
+{
+  std::vector<ProgramTelemetry> programs = getPrograms();
+  auto slowestFirst = [](const ProgramTelemetry& lhs, const ProgramTelemetry& rhs)
+  {
+    return getTotalSeconds(lhs) > getTotalSeconds(rhs);
+  };
+  std::stable_sort(programs.begin(), programs.end(), slowestFirst);
+  if (programs.size() > n)
+  {
+    programs.resize(n);
+  }
+  return programs;
+}
+
+double ShaderTelemetry::getTotalCompileSeconds() const
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  double total = 0.0;
+  for (auto it = mPrograms.begin(); it != mPrograms.end(); ++it)
+  {
+    total += it->compileSeconds;
+  }
+  return total;
+}
+
+double ShaderTelemetry::getTotalLinkSeconds() const
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  double total = 0.0;
+  for (auto it = mPrograms.begin(); it != mPrograms.end(); ++it)
+  {
+    total += it->linkSeconds;
+  }
+  return total;
+}
+
+void ShaderTelemetry::writeJSON(std::ostream& out, size_t slowestN) const
+{
+  std::vector<ProgramTelemetry> programs = getPrograms();
+  std::vector<ProgramTelemetry> slowest  = getSlowest(slowestN);
+
+  size_t numFailed = 0;
+  for (auto it = programs.begin(); it != programs.end(); ++it)
+  {
+    if (!it->success) ++numFailed;
+  }
+
+  out << "{\n"
+      << "  \"num_programs\": " << programs.size() << ",\n"
+      << "  \"num_failed\": " << numFailed << ",\n"
+      << "  \"total_compile_seconds\": " << getTotalCompileSeconds() << ",\n"
+      << "  \"total_link_seconds\": " << getTotalLinkSeconds() << ",\n"
+      << "  \"slowest\": [";
+  for (size_t i = 0; i < slowest.size(); ++i)
+  {
+    out << (i ? ", " : "") << "{\"name\": ";
+    writeJSONString(out, slowest[i].getName());
+    out << ", \"seconds\": " << getTotalSeconds(slowest[i]) << "}";
+  }
+  out << "],\n  \"programs\": [\n";
+  for (size_t i = 0; i < programs.size(); ++i)
+  {
+    out << "    ";
+    writeProgramJSON(out, programs[i]);
+    out << (i + 1 < programs.size() ? ",\n" : "\n");
+  }
+  out << "  ]\n}\n";
+}
+
+void ShaderTelemetry::clear()
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  mPrograms.clear();
+}
+
+ShaderTelemetry* setShaderTelemetry(ShaderTelemetry* telemetry)
+{
+  return sTelemetry.exchange(telemetry);
+}
+
+ShaderTelemetry* getShaderTelemetry()
+{
+  return sTelemetry.load();
+}
+
+} // namespace CPM_GL_SHADERS_NS
@@ -0,0 +1,95 @@
+/// \date   October 2026
+
+#ifndef IAUNS_GLSHADERTELEMETRY_HPP
+#define IAUNS_GLSHADERTELEMETRY_HPP
+
+#include <vector>
+#include <string>
+#include <iosfwd>
+#include <mutex>
+#include <cstdint>
+#include <gl-platform/GLPlatform.hpp>
+
+namespace CPM_GL_SHADERS_NS {
+
+/// Compile statistics of a single shader stage.
+struct ShaderStageTelemetry
+{
+  ShaderStageTelemetry() :
+      shaderType(0), sourceBytes(0), compileSeconds(0.0), success(false)
+  {}
+
+  GLenum      shaderType;
+  size_t      sourceBytes;    ///< GLSL text length, or SPIR-V module size.
+  double      compileSeconds; ///< Time until the compile status was known.
+  bool        success;
+  std::string log;            ///< Compile log, including warnings.
+};
+
+/// Compile and link statistics of a program built by loadShaderProgram.
+struct ProgramTelemetry
+{
+  ProgramTelemetry() :
+      sourceHash(0), program(0), compileSeconds(0.0), linkSeconds(0.0),
+      binaryBytes(0), success(false)
+  {}
+
+  /// Label given to loadShaderProgram, or the source hash in hex if none.
+  std::string getName() const;
+
+  std::string                       label;
+  uint64_t                          sourceHash;     ///< hashShaderSources.
+  GLuint                            program;        ///< Deleted if !success.
+  std::vector<ShaderStageTelemetry> stages;         ///< Up to the first failed stage.
+  double                            compileSeconds; ///< Sum over all stages.
+  double                            linkSeconds;
+  size_t                            binaryBytes;    ///< 0 if not queryable.
+  bool                              success;
+  std::string                       linkLog;
+};
+
+/// Collects compile and link statistics of every program built through
+/// loadShaderProgram while installed with setShaderTelemetry. Use the report
+/// to find the programs responsible for slow startup. Recording is thread
+/// safe.
+class ShaderTelemetry
+{
+public:
+  ShaderTelemetry() {}
+
+  /// Called by loadShaderProgram.
+  void record(const ProgramTelemetry& program);
+
+  /// Copy of every recorded program, in load order.
+  std::vector<ProgramTelemetry> getPrograms() const;
+
+  /// The \p n programs with the longest compile + link time, slowest first.
+  std::vector<ProgramTelemetry> getSlowest(size_t n) const;
+
+  double getTotalCompileSeconds() const;
+  double getTotalLinkSeconds() const;
+
+  /// Writes the aggregate report as JSON: totals, the \p slowestN slowest
+  /// programs, and every program's per-stage statistics.
+  void writeJSON(std::ostream& out, size_t slowestN = 10) const;
+
+  void clear();
+
+private:
+  ShaderTelemetry(const ShaderTelemetry&) = delete;
+  ShaderTelemetry& operator=(const ShaderTelemetry&) = delete;
+
+  mutable std::mutex            mMutex;
+  std::vector<ProgramTelemetry> mPrograms;
+};
+
+/// Installs the telemetry sink used by loadShaderProgram. Pass nullptr to
+/// disable telemetry (the default). Returns the previous sink.
+ShaderTelemetry* setShaderTelemetry(ShaderTelemetry* telemetry);
+
+/// Currently installed telemetry sink, or nullptr.
+ShaderTelemetry* getShaderTelemetry();
+
+} // namespace CPM_GL_SHADERS_NS
+
+#endif
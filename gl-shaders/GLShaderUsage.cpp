@@ -0,0 +1,178 @@
+/// \date   October 2026
+
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <sstream>
+#include <iostream>
+#include <exception>
+#include "GLShaderUsage.hpp"
+
+namespace CPM_GL_SHADERS_NS {
+
+namespace {
+
+std::atomic<ShaderUsageRecorder*> sRecorder(nullptr);
+
+} // anonymous namespace
+
+ShaderUsageEntry::ShaderUsageEntry() :
+    sourceHash(0),
+    baseID(0),
+    features(0),
+    firstUse(0.0),
+    loadCount(0)
+{}
+
+ShaderUsageRecorder::ShaderUsageRecorder()
+{
+  beginSession();
+}
+
+void ShaderUsageRecorder::beginSession()
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  mSessionStart = std::chrono::steady_clock::now();
+  mEntries.clear();
+  mIndex.clear();
+}
+
+void ShaderUsageRecorder::recordLoad(uint64_t sourceHash, uint32_t baseID, uint64_t features)
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  auto it = mIndex.find(sourceHash);
+  if (it != mIndex.end())
+  {
+    ++mEntries[it->second].loadCount;
+    return;
+  }
+
+  ShaderUsageEntry entry;
+  entry.sourceHash  = sourceHash;
+  entry.baseID      = baseID;
+  entry.features    = features;
+  entry.firstUse    = std::chrono::duration<double>(
+      std::chrono::steady_clock::now() - mSessionStart).count();
+  entry.loadCount   = 1;
+
+  mIndex[sourceHash] = mEntries.size();
+  mEntries.push_back(entry);
+}
+
+std::vector<ShaderUsageEntry> ShaderUsageRecorder::getProfile() const
+{
+  // Entries are appended as they are first seen, so they are already in
+  // order of first use.
+  std::lock_guard<std::mutex> lock(mMutex);
+  return mEntries;
+}
+
+void ShaderUsageRecorder::saveProfile(std::ostream& out) const
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+
+  // Enough digits for 'firstUse' to survive a round trip.
+  std::streamsize precision = out.precision(17);
+  for (auto it = mEntries.begin(); it != mEntries.end(); ++it)
+  {
+    out << std::hex << it->sourceHash << " " << std::dec << it->baseID << " "
+        << std::hex << it->features << " " << std::dec << it->firstUse << " "
+        << it->loadCount << "\n";
+  }
+  out.precision(precision);
+}
+
+bool ShaderUsageRecorder::saveProfile(const std::string& filename) const
+{
+  std::ofstream out(filename.c_str());
+  if (!out)
+  {
+    std::cerr << "ShaderUsageRecorder: Unable to open " << filename << " for writing." << std::endl;
+    return false;
+  }
+  saveProfile(out);
+  return true;
+}
+
+std::vector<ShaderUsageEntry> ShaderUsageRecorder::loadProfile(std::istream& in)
+{
+  std::vector<ShaderUsageEntry> profile;
+  std::string line;
+  while (std::getline(in, line))
+  {
+    std::istringstream fields(line);
+    ShaderUsageEntry entry;
+    fields >> std::hex >> entry.sourceHash >> std::dec >> entry.baseID
+           >> std::hex >> entry.features >> std::dec >> entry.firstUse
+           >> entry.loadCount;
+    if (fields)
+    {
+      profile.push_back(entry);
+    }
+  }
+  return profile;
+}
+
+std::vector<ShaderUsageEntry> ShaderUsageRecorder::loadProfile(const std::string& filename)
+{
+  std::ifstream in(filename.c_str());
+  if (!in)
+  {
+    return std::vector<ShaderUsageEntry>();
+  }
+  return loadProfile(in);
+}
+
+ShaderUsageRecorder* setShaderUsageRecorder(ShaderUsageRecorder* recorder)
+{
+  return sRecorder.exchange(recorder);
+}
+
+ShaderUsageRecorder* getShaderUsageRecorder()
+{
+  return sRecorder.load();
+}
+
+ShaderWarmupScheduler::ShaderWarmupScheduler(const std::vector<ShaderUsageEntry>& profile,
+                                             const CompileFunction& compile) :
+    mQueue(profile),
+    mNext(0),
+    mCompile(compile)
+{
+  auto hottestFirst = [](const ShaderUsageEntry& lhs, const ShaderUsageEntry& rhs)
+  {
+    if (lhs.firstUse != rhs.firstUse) return lhs.firstUse < rhs.firstUse;
+    return lhs.loadCount > rhs.loadCount;
+  };
+  std::stable_sort(mQueue.begin(), mQueue.end(), hottestFirst);
+}
+
+size_t ShaderWarmupScheduler::step(double budgetSeconds)
+{
+  auto start = std::chrono::steady_clock::now();
+  size_t numCompiled = 0;
+  while (mNext < mQueue.size())
+  {
+    const ShaderUsageEntry& entry = mQueue[mNext++];
+    try
+    {
+      mCompile(entry);
+    }
+    catch (const std::exception& e)
+    {
+      std::cerr << "ShaderWarmupScheduler: Failed to warm up program " << std::hex
+                << entry.sourceHash << std::dec << ": " << e.what() << std::endl;
+    }
+    ++numCompiled;
+
+    double elapsed = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - start).count();
+    if (elapsed >= budgetSeconds)
+    {
+      break;
+    }
+  }
+  return numCompiled;
+}
+
+} // namespace CPM_GL_SHADERS_NS
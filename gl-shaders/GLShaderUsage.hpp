@@ -0,0 +1,117 @@
+/// \date   October 2026
+
+#ifndef IAUNS_GLSHADERUSAGE_HPP
+#define IAUNS_GLSHADERUSAGE_HPP
+
+#include <vector>
+#include <string>
+#include <iosfwd>
+#include <functional>
+#include <unordered_map>
+#include <chrono>
+#include <mutex>
+#include <cstdint>
+
+namespace CPM_GL_SHADERS_NS {
+
+/// A single program (or program variant) observed during a session.
+struct ShaderUsageEntry
+{
+  ShaderUsageEntry();
+
+  uint64_t  sourceHash;   ///< As returned by hashShaderSources.
+  uint32_t  baseID;       ///< Variant base shader, or an application ID. 0 if unused.
+  uint64_t  features;     ///< Variant feature mask. 0 if unused.
+  double    firstUse;     ///< Seconds since the session began at first load.
+  uint32_t  loadCount;    ///< Number of times the program was loaded.
+};
+
+/// Records which programs were loaded during a session and how early. The
+/// resulting profile can be saved and replayed at the next start using
+/// ShaderWarmupScheduler. Recording is optional; nothing in this library
+/// records unless a recorder is installed with setShaderUsageRecorder or
+/// attached to a ShaderVariantManager. Recording is thread safe.
+class ShaderUsageRecorder
+{
+public:
+  /// Begins a session. Equivalent to calling 'beginSession'.
+  ShaderUsageRecorder();
+
+  /// Clears all entries and restarts the session clock.
+  void beginSession();
+
+  /// Records a program load. \p sourceHash identifies the program; repeated
+  /// loads of the same program only increment its load count.
+  void recordLoad(uint64_t sourceHash, uint32_t baseID = 0, uint64_t features = 0);
+
+  /// Retrieves the recorded entries, ordered by first use.
+  std::vector<ShaderUsageEntry> getProfile() const;
+
+  /// Writes the profile as plain text, one entry per line.
+  void saveProfile(std::ostream& out) const;
+
+  /// Same as above, but writes to \p filename. Returns false if the file could
+  /// not be opened.
+  bool saveProfile(const std::string& filename) const;
+
+  /// Reads a profile written by 'saveProfile'. Malformed lines are skipped.
+  static std::vector<ShaderUsageEntry> loadProfile(std::istream& in);
+
+  /// Same as above, but reads from \p filename. Returns an empty profile if
+  /// the file does not exist.
+  static std::vector<ShaderUsageEntry> loadProfile(const std::string& filename);
+
+private:
+  ShaderUsageRecorder(const ShaderUsageRecorder&) = delete;
+  ShaderUsageRecorder& operator=(const ShaderUsageRecorder&) = delete;
+
+  mutable std::mutex                            mMutex;
+  std::chrono::steady_clock::time_point         mSessionStart;
+  std::vector<ShaderUsageEntry>                 mEntries;
+  std::unordered_map<uint64_t, size_t>          mIndex;   ///< sourceHash -> mEntries index.
+};
+
+/// Installs the recorder used by loadShaderProgram. Every program it links
+/// successfully is recorded under hashShaderSources of its sources, with a
+/// base ID and feature mask of 0. Pass nullptr to disable recording (the
+/// default). Returns the previous recorder.
+ShaderUsageRecorder* setShaderUsageRecorder(ShaderUsageRecorder* recorder);
+
+/// Currently installed usage recorder, or nullptr.
+ShaderUsageRecorder* getShaderUsageRecorder();
+
+/// Replays a usage profile by precompiling programs in order of first use
+/// (programs used equally early are ordered by load count). Call 'step' once
+/// per frame with the time that may be spent compiling that frame.
+class ShaderWarmupScheduler
+{
+public:
+  /// Compiles the program described by the entry. Exceptions are caught and
+  /// reported by the scheduler, and the entry is skipped.
+  typedef std::function<void (const ShaderUsageEntry&)> CompileFunction;
+
+  ShaderWarmupScheduler(const std::vector<ShaderUsageEntry>& profile,
+                        const CompileFunction& compile);
+
+  /// Compiles programs until \p budgetSeconds has elapsed. The budget is
+  /// checked after each compile, so at least one program is compiled per call
+  /// (even with a budget of 0) and warm-up always makes progress; the last
+  /// compile may overrun the budget. Returns the number of programs compiled,
+  /// including ones that failed.
+  size_t step(double budgetSeconds);
+
+  /// True when every program in the profile has been compiled.
+  bool isDone() const             {return mNext == mQueue.size();}
+
+  /// Number of programs still to be compiled.
+  size_t getNumRemaining() const  {return mQueue.size() - mNext;}
+
+private:
+  std::vector<ShaderUsageEntry> mQueue;
+  size_t                        mNext;
+  CompileFunction               mCompile;
+};
+
+} // namespace CPM_GL_SHADERS_NS
+
+#endif
@@ -0,0 +1,273 @@
+/// \date   October 2026
+
+#include <stdexcept>
+#include "GLShaderVariants.hpp"
+#include "GLDispatch.hpp"
+
+namespace CPM_GL_SHADERS_NS {
+
+ShaderVariantManager::ShaderVariantManager(size_t maxPrograms, size_t maxBytes) :
+    mRecorder(nullptr),
+    mFallback(0),
+    mMaxPrograms(maxPrograms),
+    mMaxBytes(maxBytes),
+    mResidentBytes(0)
+{}
+
+ShaderVariantManager::~ShaderVariantManager()
+{
+  for (auto it = mVariants.begin(); it != mVariants.end(); ++it)
+  {
+    if (it->second.state == VARIANT_READY)
+    {
+      GLD(glDispatch().DeleteProgram(it->second.program));
+    }
+  }
+}
+
+void ShaderVariantManager::registerBase(uint32_t baseID, const ShaderVariantBase& base)
+{
+  if (base.featureNames.size() > 64 || base.featureConstants.size() > 64)
+  {
+    throw std::runtime_error("ShaderVariantManager: At most 64 features are supported.");
+  }
+
+  deleteVariantsOfBase(baseID);
+  mBases[baseID] = base;
+}
+
+void ShaderVariantManager::setBudget(size_t maxPrograms, size_t maxBytes)
+{
+  mMaxPrograms = maxPrograms;
+  mMaxBytes    = maxBytes;
+  evictToBudget();
+}
+
+GLuint ShaderVariantManager::getProgram(uint32_t baseID, uint64_t features)
+{
+  VariantKey key(baseID, features);
+  auto it = mVariants.find(key);
+  if (it != mVariants.end())
+  {
+    if (it->second.state == VARIANT_READY)
+    {
+      ++mStats.hits;
+      touch(it->second);
+      return it->second.program;
+    }
+
+    // Either pending or failed.
+    ++mStats.misses;
+    return mFallback;
+  }
+
+  if (mBases.find(baseID) == mBases.end())
+  {
+    std::cerr << "ShaderVariantManager: Unknown base shader " << baseID << std::endl;
+    throw std::runtime_error("ShaderVariantManager: Unknown base shader.");
+  }
+
+  ++mStats.misses;
+  mVariants[key] = Variant();
+  mPending.push_back(key);
+
+  if (mRecorder)
+  {
+    const ShaderVariantBase& base = mBases[baseID];
+    std::vector<std::string> strings = buildVariantStrings(base, features);
+    mRecorder->recordLoad(hashShaderSources(makeSources(base, features, strings)), baseID, features);
+  }
+
+  return mFallback;
+}
+
+bool ShaderVariantManager::precompile(uint32_t baseID, uint64_t features)
+{
+  if (mBases.find(baseID) == mBases.end())
+  {
+    std::cerr << "ShaderVariantManager: Unknown base shader " << baseID << std::endl;
+    throw std::runtime_error("ShaderVariantManager: Unknown base shader.");
+  }
+
+  VariantKey key(baseID, features);
+  Variant& variant = mVariants[key];
+  switch (variant.state)
+  {
+    case VARIANT_READY:   return true;
+    case VARIANT_FAILED:  return false;
+    case VARIANT_PENDING: break;
+  }
+
+  // The variant may be sitting in the pending queue. It is compiled now.
+  for (auto it = mPending.begin(); it != mPending.end(); ++it)
+  {
+    if (*it == key)
+    {
+      mPending.erase(it);
+      break;
+    }
+  }
+
+  return compileVariant(key, variant);
+}
+
+size_t ShaderVariantManager::processPending(size_t maxCompiles)
+{
+  size_t numProcessed = 0;
+  while (numProcessed < maxCompiles && !mPending.empty())
+  {
+    VariantKey key = mPending.front();
+    mPending.pop_front();
+
+    auto it = mVariants.find(key);
+    if (it != mVariants.end() && it->second.state == VARIANT_PENDING)
+    {
+      compileVariant(key, it->second);
+      ++numProcessed;
+    }
+  }
+  return numProcessed;
+}
+
+std::vector<std::string> ShaderVariantManager::buildVariantStrings(
+    const ShaderVariantBase& base, uint64_t features)
+{
+  std::string defines;
+  for (size_t i = 0; i < base.featureNames.size(); ++i)
+  {
+    if (features & (uint64_t(1) << i))
+    {
+      defines += "#define " + base.featureNames[i] + "\n";
+    }
+  }
+
+  std::vector<std::string> stages;
+  for (auto it = base.stages.begin(); it != base.stages.end(); ++it)
+  {
+    stages.push_back(it->isBinary() ? std::string() : base.header + defines + it->source);
+  }
+  return stages;
+}
+
+std::list<ShaderSource> ShaderVariantManager::makeSources(
+    const ShaderVariantBase& base, uint64_t features, const std::vector<std::string>& strings)
+{
+  std::vector<GLuint> constantValues;
+  for (size_t i = 0; i < base.featureConstants.size(); ++i)
+  {
+    constantValues.push_back((features & (uint64_t(1) << i)) ? 1 : 0);
+  }
+
+  std::list<ShaderSource> sources;
+  for (size_t i = 0; i < base.stages.size(); ++i)
+  {
+    const ShaderVariantBase::Stage& stage = base.stages[i];
+    if (stage.isBinary())
+    {
+      sources.push_back(ShaderSource(&stage.binary[0], stage.binary.size() * sizeof(uint32_t),
+                                     stage.shaderType, stage.entryPoint.c_str(),
+                                     base.featureConstants, constantValues));
+    }
+    else
+    {
+      sources.push_back(ShaderSource({strings[i].c_str()}, stage.shaderType));
+    }
+  }
+  return sources;
+}
+
+bool ShaderVariantManager::compileVariant(const VariantKey& key, Variant& variant)
+{
+  const ShaderVariantBase& base = mBases[key.first];
+  std::vector<std::string> strings = buildVariantStrings(base, key.second);
+
+  std::list<ShaderSource> sources = makeSources(base, key.second, strings);
+  size_t sourceBytes = 0;
+  for (size_t i = 0; i < base.stages.size(); ++i)
+  {
+    sourceBytes += strings[i].size() + base.stages[i].binary.size() * sizeof(uint32_t);
+  }
+
+  GLuint program = 0;
+  try
+  {
+    program = loadShaderProgram(sources);
+  }
+  catch (const std::exception& e)
+  {
+    std::cerr << "ShaderVariantManager: Failed to build variant " << key.second
+              << " of base shader " << key.first << ": " << e.what() << std::endl;
+    variant.state = VARIANT_FAILED;
+    ++mStats.failures;
+    return false;
+  }
+
+  // Use the driver's binary size when it is available. Otherwise fall back to
+  // the size of the source, which is a reasonable proxy for relative cost.
+  GLint binaryLength = 0;
+#ifdef GL_PROGRAM_BINARY_LENGTH
+  GLD(glDispatch().GetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &binaryLength));
+#endif
+
+  variant.state     = VARIANT_READY;
+  variant.program   = program;
+  variant.sizeBytes = binaryLength > 0 ? static_cast<size_t>(binaryLength) : sourceBytes;
+  variant.lruIt     = mLRU.insert(mLRU.begin(), key);
+  mResidentBytes += variant.sizeBytes;
+  ++mStats.compiles;
+
+  evictToBudget();
+  return true;
+}
+
+void ShaderVariantManager::touch(Variant& variant)
+{
+  mLRU.splice(mLRU.begin(), mLRU, variant.lruIt);
+}
+
+void ShaderVariantManager::evictToBudget()
+{
+  // Never evict the most recently used variant, it was either just compiled
+  // or just requested.
+  while (mLRU.size() > 1
+         && (   (mMaxPrograms != 0 && mLRU.size() > mMaxPrograms)
+             || (mMaxBytes != 0 && mResidentBytes > mMaxBytes)))
+  {
+    auto it = mVariants.find(mLRU.back());
+    mLRU.pop_back();
+
+    GLD(glDispatch().DeleteProgram(it->second.program));
+    mResidentBytes -= it->second.sizeBytes;
+    mVariants.erase(it);
+    ++mStats.evictions;
+  }
+}
+
+void ShaderVariantManager::deleteVariantsOfBase(uint32_t baseID)
+{
+  for (auto it = mVariants.begin(); it != mVariants.end();)
+  {
+    if (it->first.first == baseID)
+    {
+      if (it->second.state == VARIANT_READY)
+      {
+        GLD(glDispatch().DeleteProgram(it->second.program));
+        mResidentBytes -= it->second.sizeBytes;
+        mLRU.erase(it->second.lruIt);
+      }
+      it = mVariants.erase(it);
+    }
+    else
+    {
+      ++it;
+    }
+  }
+
+  for (auto it = mPending.begin(); it != mPending.end();)
+  {
+    if (it->first == baseID) it = mPending.erase(it);
+    else                     ++it;
+  }
+}
+
+} // namespace CPM_GL_SHADERS_NS
@@ -0,0 +1,201 @@
+/// \date   October 2026
+
+#ifndef IAUNS_GLSHADERVARIANTS_HPP
+#define IAUNS_GLSHADERVARIANTS_HPP
+
+// All functions below assume there is a valid OpenGL context active.
+#include <vector>
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <functional>
+#include <cstdint>
+#include <gl-platform/GLPlatform.hpp>
+
+#include "GLShader.hpp"
+#include "GLShaderUsage.hpp"
+
+namespace CPM_GL_SHADERS_NS {
+
+/// Description of a base shader from which variants are generated. Each
+/// variant is the base shader compiled with a set of feature toggles. Feature
+/// bit 'i' enables 'featureNames[i]', which is injected as '#define <name>'
+/// between \p header and the source of each GLSL stage.
+///
+/// SPIR-V stages can not take defines. Instead, feature bit 'i' sets the
+/// specialization constant 'featureConstants[i]' of each SPIR-V stage to 1,
+/// or to 0 when the bit is clear.
+struct ShaderVariantBase
+{
+  struct Stage
+  {
+    Stage(GLenum type, const std::string& src) :
+        shaderType(type),
+        source(src)
+    {}
+
+    /// SPIR-V stage. \p module is copied.
+    Stage(GLenum type, const std::vector<uint32_t>& module,
+          const std::string& entry = "main") :
+        shaderType(type),
+        binary(module),
+        entryPoint(entry)
+    {}
+
+    bool isBinary() const {return !binary.empty();}
+
+    GLenum                shaderType; ///< Same as ShaderSource::mShaderType.
+    std::string           source;     ///< Stage source, *without* the '#version' line.
+    std::vector<uint32_t> binary;     ///< SPIR-V module. Empty for GLSL stages.
+    std::string           entryPoint; ///< SPIR-V entry point.
+  };
+
+  std::string               header;           ///< Prepended to every GLSL stage (e.g. '#version 330\n').
+  std::vector<Stage>        stages;           ///< All stages of the program.
+  std::vector<std::string>  featureNames;     ///< Define names, indexed by feature bit.
+  std::vector<GLuint>       featureConstants; ///< Specialization constant IDs, indexed by feature bit.
+};
+
+/// Manages shader variants keyed by (base shader, feature bitmask). Variants
+/// are compiled on demand: the first request for a variant returns the
+/// fallback program and queues the variant for compilation. Queued variants
+/// are compiled in 'processPending', which should be called once per frame
+/// with a small compile budget. Least recently used variants are evicted once
+/// either the program count budget or the estimated binary size budget is
+/// exceeded.
+///
+/// A variant that fails to compile or link is remembered as failed and is not
+/// retried; requests for it keep returning the fallback program. Registering
+/// its base shader again (e.g. after fixing the source) clears the failure.
+class ShaderVariantManager
+{
+public:
+  struct Stats
+  {
+    Stats() : hits(0), misses(0), compiles(0), failures(0), evictions(0) {}
+
+    uint64_t  hits;       ///< Requests satisfied with a compiled variant.
+    uint64_t  misses;     ///< Requests answered with the fallback program.
+    uint64_t  compiles;   ///< Variants successfully compiled.
+    uint64_t  failures;   ///< Variants that failed to compile or link.
+    uint64_t  evictions;  ///< Variants deleted to stay within budget.
+  };
+
+  /// \param maxPrograms  Maximum number of resident variant programs. 0 means
+  ///                     unlimited.
+  /// \param maxBytes     Maximum estimated size, in bytes, of all resident
+  ///                     variant programs. 0 means unlimited.
+  ShaderVariantManager(size_t maxPrograms = 0, size_t maxBytes = 0);
+
+  /// Deletes all resident variant programs. The fallback program is not owned
+  /// by the manager and is not deleted.
+  ~ShaderVariantManager();
+
+  /// Registers a base shader. Replaces (and deletes all variants of) any base
+  /// shader previously registered under \p baseID, including failed ones.
+  void registerBase(uint32_t baseID, const ShaderVariantBase& base);
+
+  /// Program returned while a requested variant is not yet available.
+  void setFallbackProgram(GLuint program) {mFallback = program;}
+  GLuint getFallbackProgram() const       {return mFallback;}
+
+  /// Attaches a usage recorder (nullptr to detach). The first request for each
+  /// variant is recorded under the variant's source hash, base ID, and
+  /// feature mask, so the profile can be replayed with 'precompile'.
+  /// Variants are built with loadShaderProgram, so a recorder installed with
+  /// setShaderUsageRecorder also sees each build. If it is the same recorder,
+  /// a variant's load count includes its first request as well as its builds.
+  void setUsageRecorder(ShaderUsageRecorder* recorder) {mRecorder = recorder;}
+
+  /// Changes the budgets given in the constructor. Evicts immediately if the
+  /// new budgets are exceeded.
+  void setBudget(size_t maxPrograms, size_t maxBytes);
+
+  /// Retrieves the program for the given variant. If the variant has not been
+  /// compiled, it is queued for compilation and the fallback program is
+  /// returned. If the variant previously failed to compile, the fallback
+  /// program is returned without queueing it again.
+  GLuint getProgram(uint32_t baseID, uint64_t features);
+
+  /// Compiles the variant immediately, bypassing the pending queue. Returns
+  /// false if the variant failed to compile. Use this from a
+  /// ShaderWarmupScheduler to replay a recorded usage profile.
+  bool precompile(uint32_t baseID, uint64_t features);
+
+  /// Compiles up to \p maxCompiles pending variants, in request order.
+  /// Returns the number of variants processed.
+  size_t processPending(size_t maxCompiles);
+
+  /// Number of variants waiting to be compiled.
+  size_t getNumPending() const          {return mPending.size();}
+
+  /// Number of compiled variant programs currently resident.
+  size_t getNumResident() const         {return mLRU.size();}
+
+  /// Estimated size of all resident programs, in bytes.
+  size_t getResidentBytes() const       {return mResidentBytes;}
+
+  const Stats& getStats() const         {return mStats;}
+  void resetStats()                     {mStats = Stats();}
+
+  /// Builds the full source of every stage of the given variant: the header,
+  /// the feature defines, and the stage source. Strings are returned in the
+  /// same order as 'base.stages'; SPIR-V stages receive an empty string.
+  static std::vector<std::string> buildVariantStrings(const ShaderVariantBase& base,
+                                                      uint64_t features);
+
+private:
+  typedef std::pair<uint32_t, uint64_t> VariantKey;
+
+  struct VariantKeyHash
+  {
+    size_t operator()(const VariantKey& key) const
+    {
+      return std::hash<uint64_t>()(key.second * 0x9E3779B97F4A7C15ull ^ key.first);
+    }
+  };
+
+  enum VariantState
+  {
+    VARIANT_PENDING,
+    VARIANT_READY,
+    VARIANT_FAILED,
+  };
+
+  struct Variant
+  {
+    Variant() : state(VARIANT_PENDING), program(0), sizeBytes(0) {}
+
+    VariantState                    state;
+    GLuint                          program;
+    size_t                          sizeBytes;  ///< Estimated binary size.
+    std::list<VariantKey>::iterator lruIt;      ///< Valid only if VARIANT_READY.
+  };
+
+  /// Builds a ShaderSource list referencing \p strings and the modules of
+  /// \p base, which must outlive it.
+  static std::list<ShaderSource> makeSources(const ShaderVariantBase& base, uint64_t features,
+                                             const std::vector<std::string>& strings);
+
+  bool compileVariant(const VariantKey& key, Variant& variant);
+  void touch(Variant& variant);
+  void evictToBudget();
+  void deleteVariantsOfBase(uint32_t baseID);
+
+  std::unordered_map<uint32_t, ShaderVariantBase>           mBases;
+  std::unordered_map<VariantKey, Variant, VariantKeyHash>   mVariants;
+  std::list<VariantKey>   mLRU;       ///< Most recently used at the front.
+  std::list<VariantKey>   mPending;   ///< Variants awaiting compilation.
+
+  ShaderUsageRecorder*  mRecorder;
+
+  GLuint  mFallback;
+  size_t  mMaxPrograms;
+  size_t  mMaxBytes;
+  size_t  mResidentBytes;
+  Stats   mStats;
+};
+
+} // namespace CPM_GL_SHADERS_NS
+
+#endif
@@ -0,0 +1,130 @@
+/// \date   October 2026
+
+#include <stdexcept>
+#include <sstream>
+#include "GLVertexLayout.hpp"
+
+namespace CPM_GL_SHADERS_NS {
+
+VertexLayoutRegistry::VertexLayoutRegistry()
+{}
+
+VertexLayoutID VertexLayoutRegistry::registerVertexLayout(const ShaderAttribute* array, size_t size)
+{
+  return registerLayout(std::vector<ShaderAttribute>(array, array + size), false);
+}
+
+VertexLayoutID VertexLayoutRegistry::registerProgramLayout(const ShaderAttribute* array, size_t size)
+{
+  std::vector<ShaderAttribute> attributes(array, array + size);
+  sortAttributesAlphabetically(attributes);
+  return registerLayout(attributes, true);
+}
+
+VertexLayoutID VertexLayoutRegistry::registerLayout(std::vector<ShaderAttribute> attributes,
+                                                    bool isProgram)
+{
+  // Only the fields that affect buildPreappliedAttrib for this kind of list
+  // are part of the key.
+  std::ostringstream key;
+  key << (isProgram ? 'P' : 'V');
+  for (auto it = attributes.begin(); it != attributes.end(); ++it)
+  {
+    key << '|' << it->nameInCode << ',' << it->baseType << ',' << it->numComps;
+    if (isProgram)
+      key << ',' << it->attribLoc;
+    else
+      key << ',' << it->sizeBytes << ',' << static_cast<int>(it->normalize);
+  }
+
+  auto existing = mLayoutIndex.find(key.str());
+  if (existing != mLayoutIndex.end())
+  {
+    return existing->second;
+  }
+
+  VertexLayoutID id = static_cast<VertexLayoutID>(mLayouts.size());
+  Layout layout;
+  layout.isProgram  = isProgram;
+  layout.attributes = std::move(attributes);
+  mLayouts.push_back(std::move(layout));
+  mLayoutIndex[key.str()] = id;
+  return id;
+}
+
+void VertexLayoutRegistry::setAttributeDefaults(const std::vector<ShaderAttributeDefault>& defaults)
+{
+  mDefaults = defaults;
+
+  // Swapping keeps the elements in place, so outstanding references to
+  // layouts built with the old defaults remain valid.
+  if (!mApplied.empty())
+  {
+    mRetiredApplied.push_back(AppliedMap());
+    mRetiredApplied.back().swap(mApplied);
+  }
+}
+
+const std::vector<ShaderAttribute>& VertexLayoutRegistry::getLayout(VertexLayoutID id) const
+{
+  if (id >= mLayouts.size())
+  {
+    throw std::runtime_error("VertexLayoutRegistry: Invalid layout ID.");
+  }
+  return mLayouts[id].attributes;
+}
+
+const VertexLayoutRegistry::AppliedLayout& VertexLayoutRegistry::getAppliedLayout(
+    VertexLayoutID vboLayout, VertexLayoutID programLayout)
+{
+  uint64_t key = (static_cast<uint64_t>(vboLayout) << 32) | programLayout;
+  auto existing = mApplied.find(key);
+  if (existing != mApplied.end())
+  {
+    return existing->second;
+  }
+
+  if (vboLayout >= mLayouts.size() || programLayout >= mLayouts.size()
+      || mLayouts[vboLayout].isProgram || !mLayouts[programLayout].isProgram)
+  {
+    throw std::runtime_error("VertexLayoutRegistry: Expected a VBO layout and a program layout.");
+  }
+
+  const std::vector<ShaderAttribute>& vbo     = mLayouts[vboLayout].attributes;
+  const std::vector<ShaderAttribute>& program = mLayouts[programLayout].attributes;
+
+  AppliedLayout applied;
+  applied.compatible = true;
+  applied.stride     = 0;
+  for (auto it = program.begin(); it != program.end(); ++it)
+  {
+    if (hasAttribute(vbo.data(), vbo.size(), it->nameInCode) == -1
+        && hasAttributeDefault(mDefaults.data(), mDefaults.size(), it->nameInCode) == -1)
+    {
+      applied.compatible = false;
+      break;
+    }
+  }
+
+  if (applied.compatible && !program.empty())
+  {
+    applied.attributes.resize(program.size());
+    std::tuple<size_t, size_t> result = buildPreappliedAttrib(
+        vbo.data(), vbo.size(), program.data(), program.size(),
+        applied.attributes.data(), applied.attributes.size());
+    applied.attributes.resize(std::get<0>(result));
+    applied.stride = std::get<1>(result);
+
+    applied.constants.resize(program.size() - applied.attributes.size());
+    applied.constants.resize(buildPreappliedDefaults(
+        vbo.data(), vbo.size(), program.data(), program.size(),
+        mDefaults.data(), mDefaults.size(),
+        applied.constants.data(), applied.constants.size()));
+  }
+
+  // Elements of an unordered_map are not moved by rehashing, so references
+  // handed out earlier stay valid.
+  return mApplied.insert(std::make_pair(key, std::move(applied))).first->second;
+}
+
+} // namespace CPM_GL_SHADERS_NS
@@ -0,0 +1,100 @@
+/// \date   October 2026
+
+#ifndef IAUNS_GLVERTEXLAYOUT_HPP
+#define IAUNS_GLVERTEXLAYOUT_HPP
+
+#include <vector>
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <cstdint>
+#include <gl-platform/GLPlatform.hpp>
+
+#include "GLShader.hpp"
+
+namespace CPM_GL_SHADERS_NS {
+
+/// Identifies a canonical attribute list within a VertexLayoutRegistry.
+typedef uint32_t VertexLayoutID;
+
+/// Assigns stable integer IDs to attribute lists, so VBO formats and program
+/// input signatures can be compared by ID instead of element-wise string
+/// comparison, and memoizes the buildPreappliedAttrib result for each
+/// (VBO layout, program layout) pair.
+///
+/// VBO layouts and program layouts are separate kinds; the same list
+/// registered as both receives two IDs.
+class VertexLayoutRegistry
+{
+public:
+  /// Result of pairing a VBO layout with a program layout.
+  struct AppliedLayout
+  {
+    bool                                  compatible; ///< False if the VBO lacks an attribute of
+                                                      ///< the program that has no default.
+    std::vector<ShaderAttributeApplied>   attributes; ///< Empty if not compatible.
+    size_t                                stride;
+    std::vector<ShaderAttributeConstant>  constants;  ///< Defaults of attributes the VBO lacks.
+  };
+
+  VertexLayoutRegistry();
+
+  /// Registers the attribute list of a VBO. Order is significant, since it
+  /// determines attribute offsets, so lists are not sorted. Attributes are
+  /// compared by name, size in bytes, base type, components, and normalize.
+  VertexLayoutID registerVertexLayout(const ShaderAttribute* array, size_t size);
+
+  /// Registers a program's attribute list (see getProgramAttributes). The list
+  /// is sorted alphabetically first, so attribute order does not matter.
+  /// Attributes are compared by name, base type, components, and location.
+  VertexLayoutID registerProgramLayout(const ShaderAttribute* array, size_t size);
+
+  /// Canonical attribute list of \p id.
+  const std::vector<ShaderAttribute>& getLayout(VertexLayoutID id) const;
+
+  /// Applied attributes for drawing a VBO of layout \p vboLayout with a
+  /// program of layout \p programLayout. Built by buildPreappliedAttrib on
+  /// first use and looked up afterwards. The returned reference, and the
+  /// address of its attribute array, stay valid for the registry's lifetime,
+  /// so they can also serve as a layout identity (e.g. for DrawList), even
+  /// across calls to 'setAttributeDefaults'.
+  const AppliedLayout& getAppliedLayout(VertexLayoutID vboLayout, VertexLayoutID programLayout);
+
+  /// Constant values for program attributes that a VBO does not supply.
+  /// Applied layouts built from now on include them in 'constants'. Layouts
+  /// built before the call are retired rather than freed, so references
+  /// returned by 'getAppliedLayout' stay valid, but later calls return new
+  /// layouts with new addresses. Retired layouts are only released with the
+  /// registry, so set defaults once up front rather than per frame.
+  void setAttributeDefaults(const std::vector<ShaderAttributeDefault>& defaults);
+
+  /// True if every attribute of \p programLayout is supplied by \p vboLayout
+  /// or has a default.
+  bool isCompatible(VertexLayoutID vboLayout, VertexLayoutID programLayout)
+  {
+    return getAppliedLayout(vboLayout, programLayout).compatible;
+  }
+
+  size_t getNumLayouts() const {return mLayouts.size();}
+
+private:
+  struct Layout
+  {
+    bool                          isProgram;
+    std::vector<ShaderAttribute>  attributes;
+  };
+
+  typedef std::unordered_map<uint64_t, AppliedLayout> AppliedMap;
+
+  VertexLayoutID registerLayout(std::vector<ShaderAttribute> attributes, bool isProgram);
+
+  std::vector<Layout>                                 mLayouts;
+  std::unordered_map<std::string, VertexLayoutID>     mLayoutIndex;
+  AppliedMap                                          mApplied;
+  std::list<AppliedMap>                               mRetiredApplied; ///< Built with earlier defaults.
+  std::vector<ShaderAttributeDefault>                 mDefaults;
+};
+
+} // namespace CPM_GL_SHADERS_NS
+
+#endif
@@ -0,0 +1,224 @@
+/// \date   October 2026
+
+// Microbenchmarks for the per-draw attribute binding paths and the reflection
+// helpers. Runs against the null GL backend, so no context is required and
+// the timings reflect the library's CPU overhead only. Results are written as
+// JSON to stdout, or to the file given as the first argument.
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <gl-shaders/GLShader.hpp>
+#include <gl-shaders/GLDispatch.hpp>
+#include <gl-shaders/GLNullBackend.hpp>
+
+namespace gls = CPM_GL_SHADERS_NS;
+
+namespace {
+
+struct BenchResult
+{
+  std::string name;
+  size_t      param;
+  uint64_t    iterations;
+  double      nsPerOp;
+};
+
+std::vector<BenchResult> gResults;
+
+// Keeps the optimizer from discarding benchmarked work.
+volatile size_t gSink = 0;
+
+/// Runs \p body repeatedly until at least 50ms have elapsed and records the
+/// average time per call.
+template <typename Func>
+void runBenchmark(const std::string& name, size_t param, Func body)
+{
+  typedef std::chrono::steady_clock Clock;
+  const double minSeconds = 0.05;
+
+  // Warm up caches and branch predictors.
+  for (int i = 0; i < 100; ++i) body();
+
+  uint64_t iterations = 0;
+  uint64_t batch = 64;
+  Clock::time_point start = Clock::now();
+  double elapsed = 0.0;
+  while (elapsed < minSeconds)
+  {
+    for (uint64_t i = 0; i < batch; ++i) body();
+    iterations += batch;
+    batch *= 2;
+    elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+  }
+
+  BenchResult result;
+  result.name       = name;
+  result.param      = param;
+  result.iterations = iterations;
+  result.nsPerOp    = elapsed * 1e9 / static_cast<double>(iterations);
+  gResults.push_back(result);
+
+  std::cerr << name << "/" << param << ": " << result.nsPerOp << " ns" << std::endl;
+}
+
+std::string attribName(size_t i)
+{
+  std::ostringstream name;
+  name << "aAttrib" << i;
+  return name.str();
+}
+
+/// VBO layout with \p count vec4 attributes.
+std::vector<gls::ShaderAttribute> makeVBOLayout(size_t count)
+{
+  std::vector<gls::ShaderAttribute> attribs;
+  for (size_t i = 0; i < count; ++i)
+  {
+    attribs.push_back(gls::ShaderAttribute(attribName(i), 4, GL_FLOAT));
+  }
+  return attribs;
+}
+
+/// Shader layout using every \p step'th attribute of a VBO layout of
+/// \p supersetCount attributes.
+std::vector<gls::ShaderAttribute> makeShaderLayout(size_t supersetCount, size_t step)
+{
+  std::vector<gls::ShaderAttribute> attribs;
+  for (size_t i = 0; i < supersetCount; i += step)
+  {
+    attribs.push_back(gls::ShaderAttribute(attribName(i), 1, GL_FLOAT_VEC4,
+                                           static_cast<GLint>(attribs.size())));
+  }
+  return attribs;
+}
+
+void benchBindPaths()
+{
+  const size_t counts[] = {1, 2, 4, 8, 16};
+  for (size_t count : counts)
+  {
+    std::vector<gls::ShaderAttribute> shader = makeShaderLayout(count, 1);
+    runBenchmark("bindAllAttributes", count, [&]()
+    {
+      gls::bindAllAttributes(&shader[0], shader.size());
+      gls::unbindAllAttributes(&shader[0], shader.size());
+    });
+
+    // The VBO carries twice as many attributes as the shader consumes.
+    std::vector<gls::ShaderAttribute> vbo = makeVBOLayout(count * 2);
+    std::vector<gls::ShaderAttribute> subset = makeShaderLayout(count * 2, 2);
+    runBenchmark("bindSubsetAttributes", count, [&]()
+    {
+      gls::bindSubsetAttributes(&vbo[0], vbo.size(), &subset[0], subset.size());
+      gls::unbindSubsetAttributes(&vbo[0], vbo.size(), &subset[0], subset.size());
+    });
+
+    std::vector<gls::ShaderAttributeApplied> applied(subset.size());
+    std::tuple<size_t, size_t> built = gls::buildPreappliedAttrib(
+        &vbo[0], vbo.size(), &subset[0], subset.size(), &applied[0], applied.size());
+    runBenchmark("bindPreappliedAttrib", count, [&]()
+    {
+      gls::bindPreappliedAttrib(&applied[0], std::get<0>(built), std::get<1>(built));
+      gls::unbindPreappliedAttrib(&applied[0], std::get<0>(built));
+    });
+  }
+}
+
+void benchBuildPreapplied()
+{
+  const size_t counts[] = {16, 64, 256};
+  for (size_t count : counts)
+  {
+    std::vector<gls::ShaderAttribute> vbo = makeVBOLayout(count);
+    std::vector<gls::ShaderAttribute> subset = makeShaderLayout(count, 2);
+    std::vector<gls::ShaderAttributeApplied> applied(subset.size());
+    runBenchmark("buildPreappliedAttrib", count, [&]()
+    {
+      std::tuple<size_t, size_t> built = gls::buildPreappliedAttrib(
+          &vbo[0], vbo.size(), &subset[0], subset.size(), &applied[0], applied.size());
+      gSink = gSink + std::get<0>(built);
+    });
+  }
+}
+
+void benchLookupAndConstruction()
+{
+  const size_t counts[] = {4, 16, 64};
+  for (size_t count : counts)
+  {
+    std::vector<gls::ShaderAttribute> vbo = makeVBOLayout(count);
+    std::string last = attribName(count - 1);
+    runBenchmark("hasAttribute_hit", count, [&]()
+    {
+      gSink = gSink + static_cast<size_t>(gls::hasAttribute(&vbo[0], vbo.size(), last));
+    });
+
+    std::string missing = "aMissing";
+    runBenchmark("hasAttribute_miss", count, [&]()
+    {
+      gSink = gSink + static_cast<size_t>(gls::hasAttribute(&vbo[0], vbo.size(), missing));
+    });
+  }
+
+  std::string name = "aColorFloat";
+  runBenchmark("ShaderAttribute_construct", 1, [&]()
+  {
+    gls::ShaderAttribute attrib(name, 1, GL_FLOAT_VEC4, 0);
+    gSink = gSink + attrib.sizeBytes;
+  });
+}
+
+void writeResults(std::ostream& out)
+{
+  out << "[\n";
+  for (size_t i = 0; i < gResults.size(); ++i)
+  {
+    const BenchResult& r = gResults[i];
+    out << "  {\"name\": \"" << r.name << "\", \"param\": " << r.param
+        << ", \"iterations\": " << r.iterations << ", \"ns_per_op\": " << r.nsPerOp
+        << "}" << (i + 1 < gResults.size() ? "," : "") << "\n";
+  }
+  out << "]\n";
+}
+
+} // anonymous namespace
+
+int main(int argc, char** argv)
+{
+  gls::NullGLBackend backend;
+
+  // The null backend tracks enabled arrays for tests. Replace the per-draw
+  // entry points with empty functions so only the library's cost is measured.
+  gls::GLDispatch stub = gls::glDispatch();
+  stub.EnableVertexAttribArray  = [](GLuint) {};
+  stub.DisableVertexAttribArray = [](GLuint) {};
+  stub.VertexAttribPointer      = [](GLuint, GLint, GLenum, GLboolean, GLsizei, const void*) {};
+  const gls::GLDispatch* previous = gls::setGLDispatch(&stub);
+
+  benchBindPaths();
+  benchBuildPreapplied();
+  benchLookupAndConstruction();
+
+  gls::setGLDispatch(previous);
+
+  if (argc > 1)
+  {
+    std::ofstream out(argv[1]);
+    if (!out)
+    {
+      std::cerr << "Unable to open " << argv[1] << " for writing." << std::endl;
+      return 1;
+    }
+    writeResults(out);
+  }
+  else
+  {
+    writeResults(std::cout);
+  }
+  return 0;
+}
@@ -0,0 +1,138 @@
+/// \date   October 2026
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
+
+#include <gl-shaders/GLDrawList.hpp>
+#include <gl-shaders/GLDispatch.hpp>
+#include <gl-shaders/GLNullBackend.hpp>
+
+namespace gls = CPM_GL_SHADERS_NS;
+
+TEST(DrawList, RadixSortIsStable)
+{
+  std::mt19937_64 rng(42);
+  std::vector<uint64_t> keys;
+  for (int i = 0; i < 1000; ++i)
+  {
+    // Few distinct high digits, many duplicates.
+    keys.push_back((rng() % 7) << 48 | (rng() % 3));
+  }
+  std::vector<uint32_t> order(keys.size());
+  for (size_t i = 0; i < order.size(); ++i) order[i] = static_cast<uint32_t>(i);
+
+  std::vector<uint32_t> expected = order;
+  std::stable_sort(expected.begin(), expected.end(),
+                   [&keys](uint32_t a, uint32_t b) {return keys[a] < keys[b];});
+
+  std::vector<uint64_t> scratchKeys;
+  std::vector<uint32_t> scratchOrder;
+  gls::DrawList::radixSort(keys, order, scratchKeys, scratchOrder);
+
+  EXPECT_TRUE(std::is_sorted(keys.begin(), keys.end()));
+  EXPECT_EQ(expected, order);
+}
+
+TEST(DrawList, StateChangesOnlyAtKeyBoundaries)
+{
+  gls::NullGLBackend backend;
+
+  gls::ShaderAttributeApplied layoutA[2] =
+  {
+    {0, GL_FLOAT, 3, GL_FALSE, 0},
+    {1, GL_FLOAT, 3, GL_FALSE, 12},
+  };
+  gls::ShaderAttributeApplied layoutB[1] =
+  {
+    {0, GL_FLOAT, 3, GL_FALSE, 0},
+  };
+
+  std::vector<int> uniformCalls;
+  gls::DrawList list;
+  list.setUniformCallback([&uniformCalls](GLuint, const void* uniforms)
+  {
+    uniformCalls.push_back(*static_cast<const int*>(uniforms));
+  });
+
+  // Interleave 3 programs and 2 layouts in scene order, all in one buffer.
+  std::vector<int> payloads(300);
+  for (int i = 0; i < 300; ++i)
+  {
+    payloads[i] = i;
+    gls::DrawPacket packet;
+    packet.program       = 10 + (i % 3);
+    packet.attributes    = (i % 2) ? layoutA : layoutB;
+    packet.numAttributes = (i % 2) ? 2 : 1;
+    packet.stride        = (i % 2) ? 24 : 12;
+    packet.vertexBuffer  = 1;
+    packet.indexBuffer   = 2;
+    packet.count         = 36;
+    packet.uniforms      = &payloads[i];
+    list.add(packet);
+  }
+
+  gls::GLCallRecorder recorder;
+  list.submit();
+
+  EXPECT_EQ(300, list.getStats().draws);
+  EXPECT_EQ(3, list.getStats().programChanges);
+  EXPECT_EQ(6, list.getStats().layoutChanges);
+  EXPECT_EQ(2, list.getStats().bufferChanges);
+  EXPECT_EQ(3, recorder.getCount(gls::GLCall::UseProgram));
+  EXPECT_EQ(2, recorder.getCount(gls::GLCall::BindBuffer));
+  EXPECT_EQ(300, recorder.getCount(gls::GLCall::DrawElements));
+  EXPECT_EQ(0, backend.getNumEnabledAttribArrays());
+
+  // Draws of the same state keep submission order.
+  ASSERT_EQ(300, uniformCalls.size());
+  EXPECT_EQ(0, uniformCalls[0]);
+  EXPECT_EQ(6, uniformCalls[1]);
+
+  // Resubmitting the same list issues the same calls.
+  uint64_t total = recorder.getTotal();
+  recorder.reset();
+  list.submit();
+  EXPECT_EQ(total, recorder.getTotal());
+
+  list.clear();
+  EXPECT_EQ(0, list.getNumDraws());
+}
+
+TEST(DrawList, SetsConstantsWithTheirLayout)
+{
+  gls::NullGLBackend backend;
+
+  gls::ShaderAttributeApplied layout[1] =
+  {
+    {0, GL_FLOAT, 3, GL_FALSE, 0},
+  };
+  gls::ShaderAttributeConstant constants[1] =
+  {
+    {1, GL_FLOAT, {1.0f, 1.0f, 1.0f, 1.0f}},
+  };
+
+  gls::DrawList list;
+  for (int i = 0; i < 4; ++i)
+  {
+    gls::DrawPacket packet;
+    packet.program       = 10;
+    packet.attributes    = layout;
+    packet.numAttributes = 1;
+    packet.stride        = 12;
+    packet.constants     = (i < 2) ? constants : nullptr;
+    packet.numConstants  = (i < 2) ? 1 : 0;
+    packet.vertexBuffer  = 1;
+    packet.count         = 3;
+    list.add(packet);
+  }
+
+  gls::GLCallRecorder recorder;
+  list.submit();
+
+  // The same attribute array with and without constants is two layouts.
+  EXPECT_EQ(2, list.getStats().layoutChanges);
+  EXPECT_EQ(1, recorder.getCount(gls::GLCall::VertexAttrib4f));
+  EXPECT_EQ(2, recorder.getCount(gls::GLCall::EnableVertexAttribArray));
+  EXPECT_EQ(0, backend.getNumEnabledAttribArrays());
+}
@@ -0,0 +1,260 @@
+/// \date   October 2026
+
+#include <gtest/gtest.h>
+
+#include <gl-shaders/GLShader.hpp>
+#include <gl-shaders/GLDispatch.hpp>
+#include <gl-shaders/GLNullBackend.hpp>
+
+namespace gls = CPM_GL_SHADERS_NS;
+
+namespace {
+
+const char* VERTEX_SOURCE   = "void main() {}";
+const char* FRAGMENT_SOURCE = "void main() {}";
+
+GLuint loadTestProgram()
+{
+  return gls::loadShaderProgram(
+      {
+        gls::ShaderSource({VERTEX_SOURCE}, GL_VERTEX_SHADER),
+        gls::ShaderSource({FRAGMENT_SOURCE}, GL_FRAGMENT_SHADER),
+      });
+}
+
+/// Calls other than error checks, which are only issued in debug builds.
+uint64_t getNumCalls(const gls::GLCallRecorder& recorder)
+{
+  return recorder.getTotal() - recorder.getCount(gls::GLCall::GetError);
+}
+
+} // anonymous namespace
+
+TEST(GLDispatch, LoadProgramCallCounts)
+{
+  gls::NullGLBackend backend;
+  gls::GLCallRecorder recorder;
+
+  GLuint program = loadTestProgram();
+  EXPECT_NE(0, program);
+
+  EXPECT_EQ(1, recorder.getCount(gls::GLCall::CreateProgram));
+  EXPECT_EQ(2, recorder.getCount(gls::GLCall::CreateShader));
+  EXPECT_EQ(2, recorder.getCount(gls::GLCall::ShaderSource));
+  EXPECT_EQ(2, recorder.getCount(gls::GLCall::CompileShader));
+  EXPECT_EQ(2, recorder.getCount(gls::GLCall::AttachShader));
+  EXPECT_EQ(1, recorder.getCount(gls::GLCall::LinkProgram));
+  EXPECT_EQ(2, recorder.getCount(gls::GLCall::DeleteShader));
+
+  // Shaders are deleted once the program is linked.
+  EXPECT_EQ(1, backend.getNumLivePrograms());
+  EXPECT_EQ(0, backend.getNumLiveShaders());
+}
+
+TEST(GLDispatch, FailedCompileReleasesObjects)
+{
+  gls::NullGLBackend backend;
+  backend.setCompileStatus(false);
+
+  EXPECT_THROW(loadTestProgram(), std::runtime_error);
+  EXPECT_EQ(0, backend.getNumLivePrograms());
+  EXPECT_EQ(0, backend.getNumLiveShaders());
+
+  backend.setCompileStatus(true);
+  backend.setLinkStatus(false);
+
+  EXPECT_THROW(loadTestProgram(), std::runtime_error);
+  EXPECT_EQ(0, backend.getNumLivePrograms());
+  EXPECT_EQ(0, backend.getNumLiveShaders());
+}
+
+TEST(GLDispatch, ErrorChecks)
+{
+  gls::NullGLBackend backend;
+  gls::GLCallRecorder recorder;
+  loadTestProgram();
+
+  // Error checks go through the dispatch table, never to the driver.
+#ifdef NDEBUG
+  EXPECT_EQ(0, recorder.getCount(gls::GLCall::GetError));
+#else
+  EXPECT_LT(0, recorder.getCount(gls::GLCall::GetError));
+#endif
+  EXPECT_EQ(GLenum(GL_NO_ERROR), gls::glDispatch().GetError());
+}
+
+TEST(GLDispatch, ReflectionCallCounts)
+{
+  gls::NullGLBackend backend;
+  backend.setProgramInterface(
+      {
+        gls::ShaderAttribute("aPos", 1, GL_FLOAT_VEC3, 1),
+        gls::ShaderAttribute("aColorFloat", 1, GL_FLOAT_VEC4, 0),
+      },
+      {
+        gls::ShaderUniform("uProjIVObject", 1, GL_FLOAT_MAT4, 3),
+      });
+  GLuint program = loadTestProgram();
+
+  gls::GLCallRecorder recorder;
+  std::vector<gls::ShaderAttribute> attribs = gls::getProgramAttributes(program);
+  gls::sortAttributesAlphabetically(attribs);
+
+  ASSERT_EQ(2, attribs.size());
+  EXPECT_EQ("aColorFloat", attribs[0].nameInCode);
+  EXPECT_EQ(0, attribs[0].attribLoc);
+  EXPECT_EQ(4, attribs[0].numComps);
+  EXPECT_EQ("aPos", attribs[1].nameInCode);
+  EXPECT_EQ(1, attribs[1].attribLoc);
+
+  EXPECT_EQ(1, recorder.getCount(gls::GLCall::GetProgramiv));
+  EXPECT_EQ(2, recorder.getCount(gls::GLCall::GetActiveAttrib));
+  EXPECT_EQ(2, recorder.getCount(gls::GLCall::GetAttribLocation));
+  EXPECT_EQ(5, getNumCalls(recorder));
+
+  recorder.reset();
+  std::vector<gls::ShaderUniform> uniforms = gls::getProgramUniforms(program);
+  ASSERT_EQ(1, uniforms.size());
+  EXPECT_EQ(3, uniforms[0].uniformLoc);
+  EXPECT_EQ(3, getNumCalls(recorder));
+}
+
+TEST(GLDispatch, BindCallsPerDraw)
+{
+  gls::NullGLBackend backend;
+
+  std::vector<gls::ShaderAttribute> vboAttribs =
+  {
+    gls::ShaderAttribute("aColorFloat", 4, GL_FLOAT),
+    gls::ShaderAttribute("aNormal", 3, GL_FLOAT),
+    gls::ShaderAttribute("aPos", 3, GL_FLOAT),
+  };
+  std::vector<gls::ShaderAttribute> shaderAttribs =
+  {
+    gls::ShaderAttribute("aColorFloat", 1, GL_FLOAT_VEC4, 0),
+    gls::ShaderAttribute("aPos", 1, GL_FLOAT_VEC3, 1),
+  };
+
+  gls::GLCallRecorder recorder;
+
+  gls::bindSubsetAttributes(&vboAttribs[0], vboAttribs.size(),
+                            &shaderAttribs[0], shaderAttribs.size());
+  EXPECT_EQ(2, backend.getNumEnabledAttribArrays());
+  gls::unbindSubsetAttributes(&vboAttribs[0], vboAttribs.size(),
+                              &shaderAttribs[0], shaderAttribs.size());
+  EXPECT_EQ(0, backend.getNumEnabledAttribArrays());
+  uint64_t subsetCalls = getNumCalls(recorder);
+  EXPECT_EQ(6, subsetCalls);
+
+  gls::ShaderAttributeApplied applied[2];
+  std::tuple<size_t, size_t> result = gls::buildPreappliedAttrib(
+      &vboAttribs[0], vboAttribs.size(), &shaderAttribs[0], shaderAttribs.size(),
+      applied, 2);
+  EXPECT_EQ(0, getNumCalls(recorder) - subsetCalls);
+
+  recorder.reset();
+  gls::bindPreappliedAttrib(applied, std::get<0>(result), std::get<1>(result));
+  gls::unbindPreappliedAttrib(applied, std::get<0>(result));
+  EXPECT_EQ(2, recorder.getCount(gls::GLCall::EnableVertexAttribArray));
+  EXPECT_EQ(2, recorder.getCount(gls::GLCall::VertexAttribPointer));
+  EXPECT_EQ(2, recorder.getCount(gls::GLCall::DisableVertexAttribArray));
+  EXPECT_EQ(6, getNumCalls(recorder));
+}
+
+TEST(GLDispatch, AttributeDefaults)
+{
+  gls::NullGLBackend backend;
+
+  std::vector<gls::ShaderAttribute> vboAttribs =
+  {
+    gls::ShaderAttribute("aNormal", 3, GL_FLOAT),
+    gls::ShaderAttribute("aPos", 3, GL_FLOAT),
+  };
+  std::vector<gls::ShaderAttribute> shaderAttribs =
+  {
+    gls::ShaderAttribute("aColorFloat", 1, GL_FLOAT_VEC4, 0),
+    gls::ShaderAttribute("aPos", 1, GL_FLOAT_VEC3, 1),
+  };
+  std::vector<gls::ShaderAttributeDefault> defaults =
+  {
+    gls::ShaderAttributeDefault("aColorFloat", 1.0f, 1.0f, 1.0f, 1.0f),
+  };
+
+  gls::GLCallRecorder recorder;
+
+  gls::bindSubsetAttributes(&vboAttribs[0], vboAttribs.size(),
+                            &shaderAttribs[0], shaderAttribs.size(),
+                            &defaults[0], defaults.size());
+  EXPECT_EQ(1, recorder.getCount(gls::GLCall::VertexAttrib4f));
+  EXPECT_EQ(1, backend.getNumEnabledAttribArrays());
+  EXPECT_FALSE(backend.isAttribArrayEnabled(0));
+  gls::unbindSubsetAttributes(&vboAttribs[0], vboAttribs.size(),
+                              &shaderAttribs[0], shaderAttribs.size());
+  EXPECT_EQ(0, backend.getNumEnabledAttribArrays());
+
+  EXPECT_THROW(gls::bindSubsetAttributes(&vboAttribs[0], vboAttribs.size(),
+                                         &shaderAttribs[0], shaderAttribs.size(),
+                                         nullptr, 0),
+               std::runtime_error);
+
+  gls::ShaderAttributeApplied applied[2];
+  std::tuple<size_t, size_t> result = gls::buildPreappliedAttrib(
+      &vboAttribs[0], vboAttribs.size(), &shaderAttribs[0], shaderAttribs.size(),
+      applied, 2);
+  ASSERT_EQ(1, std::get<0>(result));
+  EXPECT_EQ(24, std::get<1>(result));
+
+  gls::ShaderAttributeConstant constants[2];
+  size_t numConstants = gls::buildPreappliedDefaults(
+      &vboAttribs[0], vboAttribs.size(), &shaderAttribs[0], shaderAttribs.size(),
+      &defaults[0], defaults.size(), constants, 2);
+  ASSERT_EQ(1, numConstants);
+  EXPECT_EQ(0, constants[0].attribLoc);
+  EXPECT_EQ(GL_FLOAT, constants[0].baseType);
+  EXPECT_EQ(1.0f, constants[0].values[3]);
+  EXPECT_THROW(gls::buildPreappliedDefaults(
+                   &vboAttribs[0], vboAttribs.size(), &shaderAttribs[0], shaderAttribs.size(),
+                   &defaults[0], defaults.size(), constants, 0),
+               std::runtime_error);
+
+  recorder.reset();
+  gls::bindPreappliedAttrib(applied, std::get<0>(result), std::get<1>(result));
+  gls::bindPreappliedDefaults(constants, numConstants);
+  gls::unbindPreappliedAttrib(applied, std::get<0>(result));
+  EXPECT_EQ(1, recorder.getCount(gls::GLCall::VertexAttrib4f));
+  EXPECT_EQ(1, recorder.getCount(gls::GLCall::VertexAttribPointer));
+  EXPECT_EQ(1, recorder.getCount(gls::GLCall::DisableVertexAttribArray));
+}
+
+#ifdef GL_VERTEX_ATTRIB_ARRAY_INTEGER
+TEST(GLDispatch, AttributeDefaultsByBaseType)
+{
+  gls::NullGLBackend backend;
+
+  std::vector<gls::ShaderAttribute> vboAttribs =
+  {
+    gls::ShaderAttribute("aPos", 3, GL_FLOAT),
+  };
+  std::vector<gls::ShaderAttribute> shaderAttribs =
+  {
+    gls::ShaderAttribute("aFloat", 1, GL_FLOAT_VEC2, 0),
+    gls::ShaderAttribute("aInt", 1, GL_INT_VEC4, 1),
+    gls::ShaderAttribute("aPos", 1, GL_FLOAT_VEC3, 2),
+    gls::ShaderAttribute("aUint", 1, GL_UNSIGNED_INT, 3),
+  };
+  std::vector<gls::ShaderAttributeDefault> defaults =
+  {
+    gls::ShaderAttributeDefault("aFloat", 0.5f),
+    gls::ShaderAttributeDefault("aInt", -1.0f),
+    gls::ShaderAttributeDefault("aUint", 7.0f),
+  };
+
+  gls::GLCallRecorder recorder;
+  gls::bindSubsetAttributes(&vboAttribs[0], vboAttribs.size(),
+                            &shaderAttribs[0], shaderAttribs.size(),
+                            &defaults[0], defaults.size());
+  EXPECT_EQ(1, recorder.getCount(gls::GLCall::VertexAttrib4f));
+  EXPECT_EQ(1, recorder.getCount(gls::GLCall::VertexAttribI4i));
+  EXPECT_EQ(1, recorder.getCount(gls::GLCall::VertexAttribI4ui));
+}
+#endif
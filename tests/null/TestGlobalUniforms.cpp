@@ -0,0 +1,175 @@
+/// \date   October 2026
+
+#include <gtest/gtest.h>
+#include <fstream>
+#include <cstdio>
+#include <cstdlib>
+#include <unistd.h>
+#include <utime.h>
+
+#include <gl-shaders/GLGlobalUniforms.hpp>
+#include <gl-shaders/GLDrawList.hpp>
+#include <gl-shaders/GLShaderReload.hpp>
+#include <gl-shaders/GLDispatch.hpp>
+#include <gl-shaders/GLNullBackend.hpp>
+
+namespace gls = CPM_GL_SHADERS_NS;
+
+namespace {
+
+const char* VERTEX_SOURCE   = "void main() {}";
+const char* FRAGMENT_SOURCE = "void main() {}";
+
+GLuint loadTestProgram()
+{
+  return gls::loadShaderProgram(
+      {
+        gls::ShaderSource({VERTEX_SOURCE}, GL_VERTEX_SHADER),
+        gls::ShaderSource({FRAGMENT_SOURCE}, GL_FRAGMENT_SHADER),
+      });
+}
+
+} // anonymous namespace
+
+TEST(GlobalUniforms, UploadOnlyChangedGlobals)
+{
+  gls::NullGLBackend backend;
+  backend.setProgramInterface({},
+      {
+        gls::ShaderUniform("uProjIVObject", 1, GL_FLOAT_MAT4, 0),
+        gls::ShaderUniform("uColor", 1, GL_FLOAT_VEC4, 1),
+        gls::ShaderUniform("uLights[0]", 4, GL_FLOAT_VEC3, 2),
+      });
+  GLuint programA = loadTestProgram();
+  backend.setProgramInterface({},
+      {
+        gls::ShaderUniform("uProjIVObject", 1, GL_FLOAT_MAT4, 3),
+        gls::ShaderUniform("uColor", 1, GL_FLOAT_VEC3, 4),
+      });
+  GLuint programB = loadTestProgram();
+
+  gls::GlobalUniformTable table;
+  gls::GlobalUniformTable::GlobalID proj   = table.addGlobal("uProjIVObject", GL_FLOAT_MAT4);
+  gls::GlobalUniformTable::GlobalID color  = table.addGlobal("uColor", GL_FLOAT_VEC4);
+  gls::GlobalUniformTable::GlobalID lights = table.addGlobal("uLights", GL_FLOAT_VEC3, 2);
+  EXPECT_THROW(table.addGlobal("uColor", GL_FLOAT_VEC4), std::runtime_error);
+
+  gls::GlobalUniformTable::GlobalID found;
+  EXPECT_TRUE(table.findGlobal("uLights", found));
+  EXPECT_EQ(lights, found);
+
+  GLfloat matrix[16] = {1.0f};
+  GLfloat rgba[4]    = {1.0f, 0.0f, 0.0f, 1.0f};
+  GLfloat xyz[6]     = {0.0f};
+  table.setFloats(proj, matrix, 16);
+  table.setFloats(color, rgba, 4);
+  EXPECT_THROW(table.setFloats(lights, xyz, 3), std::runtime_error);
+  table.setFloats(lights, xyz, 6);
+
+  gls::GLCallRecorder recorder;
+
+  // uColor of program B is a vec3 and does not match the global.
+  EXPECT_EQ(3, table.applyToProgram(programA));
+  EXPECT_EQ(1, table.applyToProgram(programB));
+  EXPECT_EQ(0, table.applyToProgram(programA));
+  EXPECT_EQ(0, table.applyToProgram(programB));
+  EXPECT_EQ(2, recorder.getCount(gls::GLCall::UniformMatrix4fv));
+  EXPECT_EQ(1, recorder.getCount(gls::GLCall::Uniform4fv));
+  EXPECT_EQ(1, recorder.getCount(gls::GLCall::Uniform3fv));
+
+  table.setFloats(proj, matrix, 16);
+  EXPECT_EQ(2, table.getVersion(proj));
+  EXPECT_EQ(1, table.applyToProgram(programA));
+  EXPECT_EQ(1, table.applyToProgram(programB));
+
+  table.forgetProgram(programA);
+  EXPECT_EQ(3, table.applyToProgram(programA));
+}
+
+TEST(GlobalUniforms, AppliedByDrawList)
+{
+  gls::NullGLBackend backend;
+  backend.setProgramInterface({}, {gls::ShaderUniform("uProjIVObject", 1, GL_FLOAT_MAT4, 0)});
+  GLuint programs[2] = {loadTestProgram(), loadTestProgram()};
+
+  gls::GlobalUniformTable table;
+  GLfloat matrix[16] = {1.0f};
+  table.setFloats(table.addGlobal("uProjIVObject", GL_FLOAT_MAT4), matrix, 16);
+
+  gls::ShaderAttributeApplied layout[1] = {{0, GL_FLOAT, 3, GL_FALSE, 0}};
+  gls::DrawList list;
+  list.setGlobalUniforms(&table);
+  for (int i = 0; i < 100; ++i)
+  {
+    gls::DrawPacket packet;
+    packet.program       = programs[i % 2];
+    packet.attributes    = layout;
+    packet.numAttributes = 1;
+    packet.stride        = 12;
+    packet.vertexBuffer  = 1;
+    packet.count         = 3;
+    list.add(packet);
+  }
+
+  gls::GLCallRecorder recorder;
+  list.submit();
+  list.submit();
+  EXPECT_EQ(200, recorder.getCount(gls::GLCall::DrawArrays));
+  EXPECT_EQ(2, recorder.getCount(gls::GLCall::UniformMatrix4fv));
+}
+
+TEST(GlobalUniforms, RelinkedPrograms)
+{
+  gls::NullGLBackend backend;
+  backend.setProgramInterface({}, {gls::ShaderUniform("uProjIVObject", 1, GL_FLOAT_MAT4, 0)});
+  GLuint program = loadTestProgram();
+
+  gls::GlobalUniformTable table;
+  GLfloat matrix[16] = {1.0f};
+  table.setFloats(table.addGlobal("uProjIVObject", GL_FLOAT_MAT4), matrix, 16);
+  EXPECT_EQ(1, table.applyToProgram(program));
+
+  // Relinking resets the program's uniforms, which the table can not see
+  // until the program is forgotten.
+  gls::linkProgram(program);
+  EXPECT_EQ(0, table.applyToProgram(program));
+  table.forgetProgram(program);
+  EXPECT_EQ(1, table.applyToProgram(program));
+
+  // Programs swapped by the reload service are forgotten from its callback.
+  char pathTemplate[] = "/tmp/gls_global_uniforms_XXXXXX";
+  int fd = mkstemp(pathTemplate);
+  ASSERT_NE(-1, fd);
+  close(fd);
+  std::string path = pathTemplate;
+  {
+    std::ofstream out(path.c_str());
+    out << "void main() {}";
+  }
+  gls::ShaderReloadService service(false);
+  gls::ShaderReloadService::ProgramID id =
+      service.addProgram({gls::ReloadableStage({path}, GL_FRAGMENT_SHADER)});
+  GLuint oldProgram = service.getProgram(id).program;
+  EXPECT_EQ(1, table.applyToProgram(oldProgram));
+
+  GLuint forgotten = 0;
+  service.setReloadCallback(
+      [&table, &forgotten](gls::ShaderReloadService::ProgramID, GLuint before, GLuint)
+      {
+        table.forgetProgram(before);
+        forgotten = before;
+      });
+  {
+    std::ofstream out(path.c_str());
+    out << "void main() { discard; }";
+  }
+  // Timestamps may be too coarse to see the write.
+  struct utimbuf times;
+  times.actime  = 1000;
+  times.modtime = 1000;
+  utime(path.c_str(), &times);
+  EXPECT_EQ(1, service.poll());
+  EXPECT_EQ(oldProgram, forgotten);
+  EXPECT_EQ(1, table.applyToProgram(service.getProgram(id).program));
+  std::remove(path.c_str());
+}
@@ -0,0 +1,104 @@
+/// \date   October 2026
+
+#include <gtest/gtest.h>
+
+#include <gl-shaders/GLMultiDraw.hpp>
+#include <gl-shaders/GLNullBackend.hpp>
+
+#ifdef GL_VERSION_4_3
+
+namespace gls = CPM_GL_SHADERS_NS;
+
+TEST(MultiDraw, OneMultiDrawPerGroup)
+{
+  gls::NullGLBackend backend;
+  backend.setProgramInterface(
+      {
+        gls::ShaderAttribute("aPos", 1, GL_FLOAT_VEC3, 0),
+        gls::ShaderAttribute("aDrawID", 1, GL_UNSIGNED_INT, 5),
+      },
+      {});
+
+  float vertices[4 * 3] = {0};
+  GLuint triangle[3] = {0, 1, 2};
+  GLuint quad[6]     = {0, 1, 2, 2, 1, 3};
+
+  {
+    gls::MeshPool pool(12, 16, 32);
+    gls::MeshPool::MeshID triangleID = pool.addMesh(vertices, 3, triangle, 3);
+    gls::MeshPool::MeshID quadID     = pool.addMesh(vertices, 4, quad, 6);
+    EXPECT_EQ(0, pool.getMesh(triangleID).baseVertex);
+    EXPECT_EQ(3, pool.getMesh(quadID).baseVertex);
+    EXPECT_EQ(3, pool.getMesh(quadID).firstIndex);
+    EXPECT_THROW(pool.addMesh(vertices, 4, quad, 30), std::runtime_error);
+
+    gls::ShaderAttributeApplied layoutA[1] = {{0, GL_FLOAT, 3, GL_FALSE, 0}};
+    gls::ShaderAttributeApplied layoutB[1] = {{0, GL_FLOAT, 3, GL_FALSE, 0}};
+
+    gls::MultiDrawBatcher batcher;
+    EXPECT_EQ(0, batcher.addDraw(1, layoutA, 1, pool, triangleID));
+    EXPECT_EQ(1, batcher.addDraw(1, layoutB, 1, pool, quadID));
+    EXPECT_EQ(2, batcher.addDraw(1, layoutA, 1, pool, quadID, 3));
+    EXPECT_EQ(3, batcher.addDraw(1, layoutA, 1, pool, triangleID));
+    EXPECT_EQ(2, batcher.getNumGroups());
+
+    gls::GLCallRecorder recorder;
+    batcher.submit();
+    EXPECT_EQ(2, recorder.getCount(gls::GLCall::MultiDrawElementsIndirect));
+    EXPECT_EQ(1, recorder.getCount(gls::GLCall::UseProgram));
+    EXPECT_EQ(1, recorder.getCount(gls::GLCall::GetAttribLocation));
+    EXPECT_EQ(0, backend.getNumEnabledAttribArrays());
+
+    // Group A holds draws 0, 2, 3; group B holds draw 1. Base instances index
+    // the per-instance draw ID stream.
+    const std::vector<gls::DrawElementsIndirectCommand>& commands = batcher.getCommands();
+    ASSERT_EQ(4, commands.size());
+    EXPECT_EQ(0, commands[0].baseInstance);
+    EXPECT_EQ(6, commands[1].count);
+    EXPECT_EQ(3, commands[1].instanceCount);
+    EXPECT_EQ(1, commands[1].baseInstance);
+    EXPECT_EQ(4, commands[2].baseInstance);
+    EXPECT_EQ(5, commands[3].baseInstance);
+    EXPECT_EQ(3, commands[3].firstIndex);
+
+    recorder.reset();
+    batcher.submit();
+    EXPECT_EQ(0, recorder.getCount(gls::GLCall::GetAttribLocation));
+    EXPECT_EQ(4, backend.getNumLiveBuffers());
+  }
+
+  EXPECT_EQ(0, backend.getNumLiveBuffers());
+}
+
+TEST(MultiDraw, ForgetsDrawIDLocations)
+{
+  gls::NullGLBackend backend;
+  backend.setProgramInterface({gls::ShaderAttribute("aDrawID", 1, GL_UNSIGNED_INT, 5)}, {});
+
+  float vertices[3 * 3] = {0};
+  GLuint triangle[3] = {0, 1, 2};
+  gls::MeshPool pool(12, 3, 3);
+  gls::MeshPool::MeshID mesh = pool.addMesh(vertices, 3, triangle, 3);
+  gls::ShaderAttributeApplied layout[1] = {{0, GL_FLOAT, 3, GL_FALSE, 0}};
+
+  gls::MultiDrawBatcher batcher;
+  batcher.addDraw(1, layout, 1, pool, mesh);
+
+  gls::GLCallRecorder recorder;
+  batcher.submit();
+  batcher.submit();
+  EXPECT_EQ(1, recorder.getCount(gls::GLCall::GetAttribLocation));
+
+  // A relinked program is looked up again.
+  batcher.forgetProgram(1);
+  batcher.submit();
+  EXPECT_EQ(2, recorder.getCount(gls::GLCall::GetAttribLocation));
+
+  // So is every program after 'clear', in case a name was recycled.
+  batcher.clear();
+  batcher.addDraw(1, layout, 1, pool, mesh);
+  batcher.submit();
+  EXPECT_EQ(3, recorder.getCount(gls::GLCall::GetAttribLocation));
+}
+
+#endif // GL_VERSION_4_3
@@ -0,0 +1,158 @@
+/// \date   October 2026
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <future>
+
+#include <gl-shaders/GLShaderCompileService.hpp>
+#include <gl-shaders/GLNullBackend.hpp>
+
+#ifdef GL_SYNC_GPU_COMMANDS_COMPLETE
+
+namespace gls = CPM_GL_SHADERS_NS;
+
+namespace {
+
+const char* VERTEX_SOURCE   = "void main() {}";
+const char* FRAGMENT_SOURCE = "void main() {}";
+
+class FakeCompileContext : public gls::ShaderCompileContext
+{
+public:
+  FakeCompileContext(std::atomic<int>& current) : mCurrent(current) {}
+
+  void makeCurrent() override {++mCurrent;}
+  void doneCurrent() override {--mCurrent;}
+
+private:
+  std::atomic<int>& mCurrent;
+};
+
+/// Fails to make the context current once \p release is ready.
+class BrokenCompileContext : public gls::ShaderCompileContext
+{
+public:
+  BrokenCompileContext(std::shared_future<void> release) : mRelease(release) {}
+
+  void makeCurrent() override
+  {
+    mRelease.wait();
+    throw std::runtime_error("no display");
+  }
+  void doneCurrent() override {}
+
+private:
+  std::shared_future<void> mRelease;
+};
+
+std::list<gls::ShaderSource> makeTestSources()
+{
+  // Copied by 'submit', so temporaries are fine.
+  std::string vertex(VERTEX_SOURCE);
+  return
+  {
+    gls::ShaderSource({vertex.c_str()}, GL_VERTEX_SHADER),
+    gls::ShaderSource({FRAGMENT_SOURCE}, GL_FRAGMENT_SHADER),
+  };
+}
+
+} // anonymous namespace
+
+TEST(ShaderCompileService, CompilesOnWorker)
+{
+  gls::NullGLBackend backend;
+  std::atomic<int> current(0);
+
+  {
+    gls::ShaderCompileService service([&current]
+    {
+      return std::unique_ptr<gls::ShaderCompileContext>(new FakeCompileContext(current));
+    });
+
+    gls::ShaderCompileService::Ticket first  = service.submit(makeTestSources(), "first");
+    gls::ShaderCompileService::Ticket second = service.submit(makeTestSources(), "second");
+    EXPECT_NE(first, second);
+
+    service.waitIdle();
+    EXPECT_EQ(0, service.getNumQueued());
+    EXPECT_EQ(1, current.load());
+
+    GLuint program = 0;
+    EXPECT_EQ(gls::ShaderCompileService::STATUS_READY, service.poll(first, program));
+    EXPECT_NE(0, program);
+    EXPECT_EQ(gls::ShaderCompileService::STATUS_UNKNOWN, service.poll(first, program));
+
+    std::vector<gls::ShaderCompileService::Result> results = service.collect();
+    ASSERT_EQ(1, results.size());
+    EXPECT_EQ(second, results[0].ticket);
+    EXPECT_NE(0, results[0].program);
+    EXPECT_NE(program, results[0].program);
+    EXPECT_EQ(2, backend.getNumLivePrograms());
+
+    // Left for the service to clean up.
+    service.submit(makeTestSources());
+    service.waitIdle();
+    EXPECT_EQ(3, backend.getNumLivePrograms());
+  }
+
+  EXPECT_EQ(0, current.load());
+  EXPECT_EQ(2, backend.getNumLivePrograms());
+  EXPECT_EQ(0, backend.getNumLiveShaders());
+}
+
+TEST(ShaderCompileService, ReportsFailures)
+{
+  gls::NullGLBackend backend;
+  backend.setLinkStatus(false);
+  std::atomic<int> current(0);
+
+  gls::ShaderCompileService service([&current]
+  {
+    return std::unique_ptr<gls::ShaderCompileContext>(new FakeCompileContext(current));
+  });
+
+  gls::ShaderCompileService::Ticket ticket = service.submit(makeTestSources());
+  service.waitIdle();
+
+  GLuint program = 1;
+  std::string error;
+  EXPECT_EQ(gls::ShaderCompileService::STATUS_FAILED, service.poll(ticket, program, &error));
+  EXPECT_EQ(0, program);
+  EXPECT_FALSE(error.empty());
+  EXPECT_EQ(0, backend.getNumLivePrograms());
+}
+
+TEST(ShaderCompileService, FailsWithoutContext)
+{
+  gls::NullGLBackend backend;
+  std::promise<void> release;
+  std::shared_future<void> released = release.get_future().share();
+
+  gls::ShaderCompileService service([released]
+  {
+    return std::unique_ptr<gls::ShaderCompileContext>(new BrokenCompileContext(released));
+  });
+
+  // Queued before the context fails.
+  gls::ShaderCompileService::Ticket queued = service.submit(makeTestSources());
+  release.set_value();
+  service.waitIdle();
+
+  GLuint program = 1;
+  std::string error;
+  EXPECT_EQ(gls::ShaderCompileService::STATUS_FAILED, service.poll(queued, program, &error));
+  EXPECT_EQ(0, program);
+  EXPECT_NE(std::string::npos, error.find("no display"));
+
+  // Submitted after the worker stopped.
+  gls::ShaderCompileService::Ticket later = service.submit(makeTestSources());
+  EXPECT_EQ(0, service.getNumQueued());
+  std::vector<gls::ShaderCompileService::Result> results = service.collect();
+  ASSERT_EQ(1, results.size());
+  EXPECT_EQ(later, results[0].ticket);
+  EXPECT_EQ(0, results[0].program);
+  EXPECT_EQ(error, results[0].error);
+  EXPECT_EQ(0, backend.getNumLivePrograms());
+}
+
+#endif // GL_SYNC_GPU_COMMANDS_COMPLETE
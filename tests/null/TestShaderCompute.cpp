@@ -0,0 +1,106 @@
+/// \date   October 2026
+
+#include <gtest/gtest.h>
+
+#include <gl-shaders/GLShaderCompute.hpp>
+#include <gl-shaders/GLDispatch.hpp>
+#include <gl-shaders/GLNullBackend.hpp>
+
+#ifdef GL_COMPUTE_SHADER
+
+namespace gls = CPM_GL_SHADERS_NS;
+
+namespace {
+
+const char* COMPUTE_SOURCE =
+    "layout(local_size_x = 64) in;\n"
+    "void main() {}\n";
+
+GLuint loadComputeProgram()
+{
+  return gls::loadShaderProgram({gls::ShaderSource({COMPUTE_SOURCE}, GL_COMPUTE_SHADER)});
+}
+
+} // anonymous namespace
+
+TEST(ShaderCompute, GroupCount)
+{
+  const GLint  localSize[3] = {64, 8, 1};
+  const GLuint problem[3]   = {1000, 16, 3};
+  GLuint groups[3];
+  gls::getComputeGroupCount(localSize, problem, groups);
+  EXPECT_EQ(16, groups[0]);
+  EXPECT_EQ(2, groups[1]);
+  EXPECT_EQ(3, groups[2]);
+
+  // Rounding up must not overflow near the top of the range.
+  const GLuint large[3] = {0xFFFFFFFFu, 0xFFFFFFF8u, 0};
+  gls::getComputeGroupCount(localSize, large, groups);
+  EXPECT_EQ(0x04000000u, groups[0]);
+  EXPECT_EQ(0x1FFFFFFFu, groups[1]);
+  EXPECT_EQ(0, groups[2]);
+}
+
+TEST(ShaderCompute, ReflectAndDispatch)
+{
+  gls::NullGLBackend backend;
+  GLuint notCompute = loadComputeProgram();
+  EXPECT_THROW(gls::getComputeProgramInfo(notCompute), std::runtime_error);
+
+  const GLint localSize[3] = {64, 1, 1};
+  backend.setComputeInterface(localSize,
+      {
+        gls::ShaderStorageBlock("Positions", 0, 0, 16),
+        gls::ShaderStorageBlock("Normals", 1, 1, 16),
+      });
+  backend.setProgramInterface({}, {gls::ShaderUniform("uOutput", 1, GL_IMAGE_2D, 2)});
+  GLuint program = loadComputeProgram();
+
+  gls::ComputeProgramInfo info = gls::getComputeProgramInfo(program);
+  EXPECT_EQ(64, info.workGroupSize[0]);
+  ASSERT_EQ(2, info.storageBlocks.size());
+  EXPECT_EQ("Normals", info.storageBlocks[1].nameInCode);
+  EXPECT_EQ(1, info.storageBlocks[1].binding);
+  ASSERT_EQ(1, info.images.size());
+  EXPECT_EQ(2, info.images[0].uniformLoc);
+  EXPECT_EQ(1, info.images[0].size);
+  EXPECT_EQ(1, info.images[0].units.size());
+  EXPECT_TRUE(info.atomicCounters.empty());
+
+  gls::GLCallRecorder recorder;
+  gls::dispatchCompute(program, info, {{"Positions", 10}, {"Normals", 11}}, 1000);
+  EXPECT_EQ(2, recorder.getCount(gls::GLCall::BindBufferBase));
+  EXPECT_EQ(1, recorder.getCount(gls::GLCall::DispatchCompute));
+
+  EXPECT_THROW(gls::dispatchCompute(program, info, {{"Missing", 12}}, 1000),
+               std::runtime_error);
+}
+
+TEST(ShaderCompute, ImageArrays)
+{
+  gls::NullGLBackend backend;
+  const GLint localSize[3] = {8, 8, 1};
+  backend.setComputeInterface(localSize, {});
+  backend.setProgramInterface({},
+      {
+        gls::ShaderUniform("uLayers[0]", 3, GL_IMAGE_2D, 4),
+        gls::ShaderUniform("uOutput", 1, GL_IMAGE_2D, 7),
+      });
+  GLuint program = loadComputeProgram();
+
+  gls::GLCallRecorder recorder;
+  std::vector<gls::ShaderImageUniform> images = gls::getProgramImages(program);
+  ASSERT_EQ(2, images.size());
+  EXPECT_EQ(3, images[0].size);
+  EXPECT_EQ(3, images[0].units.size());
+  EXPECT_EQ(1, images[1].units.size());
+
+  // Every element's unit is queried, elements past the first by name (on top
+  // of one lookup per uniform during reflection).
+  EXPECT_EQ(4, recorder.getCount(gls::GLCall::GetUniformiv));
+  EXPECT_EQ(4, recorder.getCount(gls::GLCall::GetUniformLocation));
+  EXPECT_EQ(5, gls::glDispatch().GetUniformLocation(program, "uLayers[1]"));
+  EXPECT_EQ(-1, gls::glDispatch().GetUniformLocation(program, "uLayers[3]"));
+}
+
+#endif // GL_COMPUTE_SHADER
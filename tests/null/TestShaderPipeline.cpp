@@ -0,0 +1,125 @@
+/// \date   October 2026
+
+#include <gtest/gtest.h>
+
+#include <gl-shaders/GLShaderPipeline.hpp>
+#include <gl-shaders/GLDispatch.hpp>
+#include <gl-shaders/GLNullBackend.hpp>
+
+#ifdef GL_PROGRAM_SEPARABLE
+
+namespace gls = CPM_GL_SHADERS_NS;
+
+TEST(ShaderPipeline, PerStageReflection)
+{
+  gls::NullGLBackend backend;
+
+  backend.setProgramInterface({gls::ShaderAttribute("aPos", 1, GL_FLOAT_VEC3, 0)},
+                              {gls::ShaderUniform("uMVP", 1, GL_FLOAT_MAT4, 0)});
+  gls::SeparableStage vertex = gls::loadSeparableStage(
+      gls::ShaderSource({"void main() {}"}, GL_VERTEX_SHADER));
+
+  // Fragment stages report no attributes, whatever the program reports.
+  backend.setProgramInterface({gls::ShaderAttribute("aPos", 1, GL_FLOAT_VEC3, 0)},
+                              {gls::ShaderUniform("uColor", 1, GL_FLOAT_VEC4, 0)});
+  gls::SeparableStage fragment = gls::loadSeparableStage(
+      gls::ShaderSource({"void main() {}"}, GL_FRAGMENT_SHADER));
+
+  EXPECT_EQ(GL_VERTEX_SHADER, vertex.shaderType);
+  ASSERT_EQ(1, vertex.attributes.size());
+  EXPECT_EQ("aPos", vertex.attributes[0].nameInCode);
+  ASSERT_EQ(1, vertex.uniforms.size());
+  EXPECT_EQ("uMVP", vertex.uniforms[0].nameInCode);
+
+  EXPECT_EQ(GL_FRAGMENT_SHADER, fragment.shaderType);
+  EXPECT_TRUE(fragment.attributes.empty());
+  ASSERT_EQ(1, fragment.uniforms.size());
+  EXPECT_EQ("uColor", fragment.uniforms[0].nameInCode);
+
+  EXPECT_EQ(GL_VERTEX_SHADER_BIT, gls::getShaderStageBit(GL_VERTEX_SHADER));
+  EXPECT_EQ(GL_FRAGMENT_SHADER_BIT, gls::getShaderStageBit(GL_FRAGMENT_SHADER));
+  EXPECT_THROW(gls::getShaderStageBit(GL_FLOAT), std::runtime_error);
+
+  gls::deleteSeparableStage(vertex);
+  gls::deleteSeparableStage(fragment);
+  EXPECT_EQ(0, vertex.program);
+  EXPECT_EQ(0, backend.getNumLivePrograms());
+
+  backend.setLinkStatus(false);
+  EXPECT_THROW(gls::loadSeparableStage(gls::ShaderSource({"void main() {}"}, GL_VERTEX_SHADER)),
+               std::runtime_error);
+  EXPECT_EQ(0, backend.getNumLivePrograms());
+}
+
+TEST(ShaderPipeline, LinksPerStage)
+{
+  gls::NullGLBackend backend;
+  gls::GLCallRecorder recorder;
+
+  // Three vertex and four fragment stages: seven links, twelve combinations.
+  std::vector<gls::SeparableStage> vertices;
+  std::vector<gls::SeparableStage> fragments;
+  for (int i = 0; i < 3; ++i)
+  {
+    vertices.push_back(gls::loadSeparableStage(
+        gls::ShaderSource({"void main() {}"}, GL_VERTEX_SHADER)));
+  }
+  for (int i = 0; i < 4; ++i)
+  {
+    fragments.push_back(gls::loadSeparableStage(
+        gls::ShaderSource({"void main() {}"}, GL_FRAGMENT_SHADER)));
+  }
+
+  gls::ProgramPipelineCache cache;
+  for (auto vertex = vertices.begin(); vertex != vertices.end(); ++vertex)
+  {
+    for (auto fragment = fragments.begin(); fragment != fragments.end(); ++fragment)
+    {
+      gls::SeparableStage stages[2] = {*vertex, *fragment};
+      EXPECT_NE(0, cache.getPipeline(stages, 2));
+    }
+  }
+  EXPECT_EQ(7, recorder.getCount(gls::GLCall::LinkProgram));
+  EXPECT_EQ(12, cache.getNumPipelines());
+  EXPECT_EQ(12, recorder.getCount(gls::GLCall::GenProgramPipelines));
+}
+
+TEST(ShaderPipeline, CacheKeyedBySortedStages)
+{
+  gls::NullGLBackend backend;
+  gls::SeparableStage vertex = gls::loadSeparableStage(
+      gls::ShaderSource({"void main() {}"}, GL_VERTEX_SHADER));
+  gls::SeparableStage fragment = gls::loadSeparableStage(
+      gls::ShaderSource({"void main() {}"}, GL_FRAGMENT_SHADER));
+  gls::SeparableStage otherFragment = gls::loadSeparableStage(
+      gls::ShaderSource({"void main() {}"}, GL_FRAGMENT_SHADER));
+
+  gls::GLCallRecorder recorder;
+  {
+    gls::ProgramPipelineCache cache;
+    gls::SeparableStage forward[2] = {vertex, fragment};
+    gls::SeparableStage reverse[2] = {fragment, vertex};
+    gls::SeparableStage other[2]   = {vertex, otherFragment};
+
+    // The same stages in any order share one pipeline.
+    GLuint pipeline = cache.getPipeline(forward, 2);
+    EXPECT_EQ(pipeline, cache.getPipeline(reverse, 2));
+    EXPECT_EQ(pipeline, cache.getPipeline(forward, 2));
+    EXPECT_NE(pipeline, cache.getPipeline(other, 2));
+    EXPECT_EQ(2, cache.getNumPipelines());
+    EXPECT_EQ(2, recorder.getCount(gls::GLCall::GenProgramPipelines));
+
+    // Removing a stage deletes only the pipelines that use it.
+    cache.removeStage(fragment.program);
+    EXPECT_EQ(1, cache.getNumPipelines());
+    EXPECT_EQ(1, recorder.getCount(gls::GLCall::DeleteProgramPipelines));
+
+    // The combination is created again on the next request.
+    cache.getPipeline(reverse, 2);
+    EXPECT_EQ(2, cache.getNumPipelines());
+    EXPECT_EQ(3, recorder.getCount(gls::GLCall::GenProgramPipelines));
+  }
+  EXPECT_EQ(3, recorder.getCount(gls::GLCall::DeleteProgramPipelines));
+}
+
+#endif // GL_PROGRAM_SEPARABLE
@@ -0,0 +1,305 @@
+/// \date   October 2026
+
+#include <gtest/gtest.h>
+#include <fstream>
+#include <cstdlib>
+#include <cstdio>
+#include <utime.h>
+#include <unistd.h>
+
+#include <gl-shaders/GLShaderReload.hpp>
+#include <gl-shaders/GLDispatch.hpp>
+#include <gl-shaders/GLNullBackend.hpp>
+
+namespace gls = CPM_GL_SHADERS_NS;
+
+namespace {
+
+/// Temporary directory of shader files. Modification times are set
+/// explicitly so changes are seen by the mtime fallback regardless of the
+/// file system's timestamp resolution.
+class ShaderDirectory
+{
+public:
+  ShaderDirectory()
+  {
+    char path[] = "/tmp/gls_reload_XXXXXX";
+    if (mkdtemp(path) == nullptr) throw std::runtime_error("mkdtemp failed.");
+    mPath = path;
+  }
+
+  ~ShaderDirectory()
+  {
+    for (auto it = mFiles.begin(); it != mFiles.end(); ++it)
+    {
+      std::remove(it->c_str());
+    }
+    rmdir(mPath.c_str());
+  }
+
+  std::string write(const std::string& name, const std::string& contents, time_t mtime)
+  {
+    std::string path = mPath + "/" + name;
+    {
+      std::ofstream out(path.c_str(), std::ios::out | std::ios::binary);
+      out << contents;
+    }
+    struct utimbuf times;
+    times.actime  = mtime;
+    times.modtime = mtime;
+    utime(path.c_str(), &times);
+    mFiles.push_back(path);
+    return path;
+  }
+
+private:
+  std::string               mPath;
+  std::vector<std::string>  mFiles;
+};
+
+} // anonymous namespace
+
+TEST(ShaderReload, SkipsUnchangedSource)
+{
+  gls::NullGLBackend backend;
+  ShaderDirectory dir;
+  std::string vs = dir.write("a.vs", "void main() {}", 1000);
+  std::string fs = dir.write("a.fs", "void main() {}", 1000);
+
+  gls::ShaderReloadService service(false);
+  gls::ShaderReloadService::ProgramID id = service.addProgram(
+      {gls::ReloadableStage({vs}, GL_VERTEX_SHADER),
+       gls::ReloadableStage({fs}, GL_FRAGMENT_SHADER)});
+  GLuint program = service.getProgram(id).program;
+  EXPECT_EQ(0, service.poll());
+
+  // Saving without modifying the source does not relink.
+  dir.write("a.fs", "void main() {}", 2000);
+  EXPECT_EQ(0, service.poll());
+  EXPECT_EQ(program, service.getProgram(id).program);
+  EXPECT_EQ(0, service.getProgram(id).generation);
+}
+
+TEST(ShaderReload, SwapsAndReflects)
+{
+  gls::NullGLBackend backend;
+  ShaderDirectory dir;
+  std::string vs = dir.write("a.vs", "void main() {}", 1000);
+  std::string fs = dir.write("a.fs", "void main() {}", 1000);
+
+  gls::ShaderReloadService service(false);
+  gls::ShaderReloadService::ProgramID id = service.addProgram(
+      {gls::ReloadableStage({vs}, GL_VERTEX_SHADER),
+       gls::ReloadableStage({fs}, GL_FRAGMENT_SHADER)});
+  GLuint oldProgram = service.getProgram(id).program;
+  EXPECT_TRUE(service.getProgram(id).attributes.empty());
+
+  std::vector<GLuint> swapped;
+  service.setReloadCallback(
+      [&swapped](gls::ShaderReloadService::ProgramID, GLuint before, GLuint after)
+      {
+        swapped.push_back(before);
+        swapped.push_back(after);
+      });
+
+  backend.setProgramInterface(
+      {gls::ShaderAttribute("aPos", 3, GL_FLOAT, 0), gls::ShaderAttribute("aColor", 4, GL_FLOAT, 1)},
+      {gls::ShaderUniform("uMVP", 1, GL_FLOAT_MAT4, 0)});
+  dir.write("a.vs", "void main() { gl_Position = vec4(0.0); }", 2000);
+  EXPECT_EQ(1, service.poll());
+
+  const gls::ShaderReloadService::Program& state = service.getProgram(id);
+  EXPECT_NE(oldProgram, state.program);
+  EXPECT_EQ(1, state.generation);
+  ASSERT_EQ(2, state.attributes.size());
+  EXPECT_EQ("aColor", state.attributes[0].nameInCode);
+  EXPECT_EQ("aPos", state.attributes[1].nameInCode);
+  ASSERT_EQ(1, state.uniforms.size());
+  EXPECT_EQ("uMVP", state.uniforms[0].nameInCode);
+  EXPECT_EQ(std::vector<GLuint>({oldProgram, state.program}), swapped);
+
+  // The old program and shader object were deleted.
+  EXPECT_EQ(1, backend.getNumLivePrograms());
+  EXPECT_EQ(2, backend.getNumLiveShaders());
+}
+
+TEST(ShaderReload, KeepsProgramWhenRebuildFails)
+{
+  gls::NullGLBackend backend;
+  ShaderDirectory dir;
+  std::string vs = dir.write("a.vs", "void main() {}", 1000);
+  std::string fs = dir.write("a.fs", "void main() {}", 1000);
+
+  gls::ShaderReloadService service(false);
+  gls::ShaderReloadService::ProgramID id = service.addProgram(
+      {gls::ReloadableStage({vs}, GL_VERTEX_SHADER),
+       gls::ReloadableStage({fs}, GL_FRAGMENT_SHADER)});
+  GLuint program = service.getProgram(id).program;
+
+  backend.setLinkStatus(false);
+  dir.write("a.fs", "void main() { discard; }", 2000);
+  EXPECT_EQ(0, service.poll());
+  EXPECT_EQ(program, service.getProgram(id).program);
+  EXPECT_EQ(0, service.getProgram(id).generation);
+  EXPECT_EQ(1, backend.getNumLivePrograms());
+
+  backend.setLinkStatus(true);
+  backend.setCompileStatus(false);
+  dir.write("a.fs", "void main() { broken }", 3000);
+  EXPECT_EQ(0, service.poll());
+  EXPECT_EQ(program, service.getProgram(id).program);
+  EXPECT_EQ(2, backend.getNumLiveShaders());
+
+  // Reverting to the running source needs no relink.
+  backend.setCompileStatus(true);
+  dir.write("a.fs", "void main() {}", 4000);
+  EXPECT_EQ(0, service.poll());
+  EXPECT_EQ(program, service.getProgram(id).program);
+
+  dir.write("a.fs", "void main() { }", 5000);
+  EXPECT_EQ(1, service.poll());
+  EXPECT_NE(program, service.getProgram(id).program);
+  EXPECT_EQ(2, backend.getNumLiveShaders());
+}
+
+TEST(ShaderReload, RetriesFailedLinkWhenAnotherStageChanges)
+{
+  gls::NullGLBackend backend;
+  ShaderDirectory dir;
+  std::string vs = dir.write("a.vs", "void main() {}", 1000);
+  std::string fs = dir.write("a.fs", "void main() {}", 1000);
+
+  gls::ShaderReloadService service(false);
+  gls::ShaderReloadService::ProgramID id = service.addProgram(
+      {gls::ReloadableStage({vs}, GL_VERTEX_SHADER),
+       gls::ReloadableStage({fs}, GL_FRAGMENT_SHADER)});
+  GLuint program = service.getProgram(id).program;
+
+  // The vertex stage changes its outputs and no longer links with the
+  // fragment stage. It stays pending without relinking on every poll.
+  backend.setLinkStatus(false);
+  dir.write("a.vs", "out vec3 vNormal; void main() {}", 2000);
+  EXPECT_EQ(0, service.poll());
+  backend.setLinkStatus(true);
+  gls::GLCallRecorder recorder;
+  EXPECT_EQ(0, service.poll());
+  EXPECT_EQ(0, recorder.getCount(gls::GLCall::LinkProgram));
+  EXPECT_EQ(3, backend.getNumLiveShaders());
+
+  // Fixing the fragment stage relinks with the pending vertex stage.
+  dir.write("a.fs", "in vec3 vNormal; void main() {}", 2000);
+  EXPECT_EQ(1, service.poll());
+  EXPECT_NE(program, service.getProgram(id).program);
+  EXPECT_EQ(1, service.getProgram(id).generation);
+  EXPECT_EQ(2, backend.getNumLiveShaders());
+  EXPECT_EQ(0, service.poll());
+}
+
+#if defined(__linux__)
+TEST(ShaderReload, DetectsChangesWithInotify)
+{
+  gls::NullGLBackend backend;
+  ShaderDirectory dir;
+  std::string vs = dir.write("a.vs", "void main() {}", 1000);
+  std::string fs = dir.write("a.fs", "void main() {}", 1000);
+
+  gls::ShaderReloadService service;
+  if (!service.isUsingNotify())
+  {
+    std::cerr << "inotify unavailable, skipping." << std::endl;
+    return;
+  }
+  gls::ShaderReloadService::ProgramID id = service.addProgram(
+      {gls::ReloadableStage({vs}, GL_VERTEX_SHADER),
+       gls::ReloadableStage({fs}, GL_FRAGMENT_SHADER)});
+  GLuint program = service.getProgram(id).program;
+  EXPECT_EQ(0, service.poll());
+
+  // Written in place, keeping the same modification time.
+  dir.write("a.fs", "void main() { discard; }", 1000);
+  EXPECT_EQ(1, service.poll());
+  EXPECT_NE(program, service.getProgram(id).program);
+  program = service.getProgram(id).program;
+
+  // Saved the way most editors do: written to a temporary file and renamed
+  // over the original.
+  std::string temp = dir.write("a.vs.tmp", "void main() { gl_Position = vec4(0.0); }", 1000);
+  ASSERT_EQ(0, std::rename(temp.c_str(), vs.c_str()));
+  EXPECT_EQ(1, service.poll());
+  EXPECT_NE(program, service.getProgram(id).program);
+
+  // Files outside the program are ignored.
+  dir.write("other.fs", "void main() {}", 1000);
+  EXPECT_EQ(0, service.poll());
+}
+#endif
+
+TEST(ShaderReload, LeavesUnaffectedPrograms)
+{
+  gls::NullGLBackend backend;
+  ShaderDirectory dir;
+  std::string vs  = dir.write("shared.vs", "void main() {}", 1000);
+  std::string fs1 = dir.write("a.fs", "void main() {}", 1000);
+  std::string fs2 = dir.write("b.fs", "void main() { }", 1000);
+
+  gls::ShaderReloadService service(false);
+  gls::ShaderReloadService::ProgramID a = service.addProgram(
+      {gls::ReloadableStage({vs}, GL_VERTEX_SHADER),
+       gls::ReloadableStage({fs1}, GL_FRAGMENT_SHADER)});
+  gls::ShaderReloadService::ProgramID b = service.addProgram(
+      {gls::ReloadableStage({vs}, GL_VERTEX_SHADER),
+       gls::ReloadableStage({fs2}, GL_FRAGMENT_SHADER)});
+  GLuint programA = service.getProgram(a).program;
+  GLuint programB = service.getProgram(b).program;
+
+  // The shared vertex stage is compiled once.
+  EXPECT_EQ(3, backend.getNumLiveShaders());
+
+  dir.write("b.fs", "void main() { discard; }", 2000);
+  EXPECT_EQ(1, service.poll());
+  EXPECT_EQ(programA, service.getProgram(a).program);
+  EXPECT_EQ(0, service.getProgram(a).generation);
+  EXPECT_NE(programB, service.getProgram(b).program);
+
+  // Changing the shared stage relinks both.
+  dir.write("shared.vs", "void main() { gl_Position = vec4(1.0); }", 2000);
+  EXPECT_EQ(2, service.poll());
+  EXPECT_NE(programA, service.getProgram(a).program);
+}
+
+TEST(ShaderReload, ReleasesStagesOnFailedAdd)
+{
+  gls::NullGLBackend backend;
+  ShaderDirectory dir;
+  std::string vs = dir.write("a.vs", "void main() {}", 1000);
+  std::string fs = dir.write("a.fs", "void main() {}", 1000);
+  std::string other = dir.write("b.fs", "void main() { discard; }", 1000);
+
+  gls::ShaderReloadService service(false);
+  service.addProgram({gls::ReloadableStage({vs}, GL_VERTEX_SHADER),
+                      gls::ReloadableStage({fs}, GL_FRAGMENT_SHADER)});
+  EXPECT_EQ(2, backend.getNumLiveShaders());
+
+  // The new fragment stage is released; the shared vertex stage is kept.
+  backend.setLinkStatus(false);
+  EXPECT_THROW(service.addProgram({gls::ReloadableStage({vs}, GL_VERTEX_SHADER),
+                                   gls::ReloadableStage({other}, GL_FRAGMENT_SHADER)}),
+               std::runtime_error);
+  EXPECT_EQ(2, backend.getNumLiveShaders());
+  EXPECT_EQ(1, backend.getNumLivePrograms());
+
+  // Unreadable files release stages acquired earlier in the same call.
+  backend.setLinkStatus(true);
+  EXPECT_THROW(service.addProgram({gls::ReloadableStage({other}, GL_FRAGMENT_SHADER),
+                                   gls::ReloadableStage({vs + ".missing"}, GL_VERTEX_SHADER)}),
+               std::runtime_error);
+  EXPECT_EQ(2, backend.getNumLiveShaders());
+
+  // Released files are no longer watched and the stage can be acquired again.
+  dir.write("b.fs", "void main() {}", 2000);
+  EXPECT_EQ(0, service.poll());
+  service.addProgram({gls::ReloadableStage({vs}, GL_VERTEX_SHADER),
+                      gls::ReloadableStage({other}, GL_FRAGMENT_SHADER)});
+  EXPECT_EQ(3, backend.getNumLiveShaders());
+  EXPECT_EQ(2, backend.getNumLivePrograms());
+}
@@ -0,0 +1,62 @@
+/// \date   October 2026
+
+#include <sstream>
+#include <cstring>
+#include <gtest/gtest.h>
+
+#include <gl-shaders/GLShader.hpp>
+#include <gl-shaders/GLShaderTelemetry.hpp>
+#include <gl-shaders/GLNullBackend.hpp>
+
+namespace gls = CPM_GL_SHADERS_NS;
+
+TEST(ShaderTelemetry, RecordsProgramsAndStages)
+{
+  gls::NullGLBackend backend;
+  gls::ShaderTelemetry telemetry;
+  gls::setShaderTelemetry(&telemetry);
+
+  const char* vertex   = "void main() { gl_Position = vec4(0.0); }";
+  const char* fragment = "void main() {}";
+  std::list<gls::ShaderSource> sources =
+  {
+    gls::ShaderSource({vertex}, GL_VERTEX_SHADER),
+    gls::ShaderSource({fragment}, GL_FRAGMENT_SHADER),
+  };
+
+  GLuint program = gls::loadShaderProgram(sources, "Color");
+  gls::loadShaderProgram(sources);
+
+  backend.setLinkStatus(false);
+  EXPECT_THROW(gls::loadShaderProgram(sources, "Broken"), std::runtime_error);
+
+  backend.setLinkStatus(true);
+  gls::setShaderTelemetry(nullptr);
+  gls::loadShaderProgram(sources, "NotRecorded");
+
+  std::vector<gls::ProgramTelemetry> programs = telemetry.getPrograms();
+  ASSERT_EQ(3, programs.size());
+
+  EXPECT_EQ("Color", programs[0].getName());
+  EXPECT_EQ(program, programs[0].program);
+  EXPECT_TRUE(programs[0].success);
+  ASSERT_EQ(2, programs[0].stages.size());
+  EXPECT_EQ(GL_VERTEX_SHADER, programs[0].stages[0].shaderType);
+  EXPECT_EQ(std::strlen(vertex), programs[0].stages[0].sourceBytes);
+  EXPECT_EQ(std::strlen(fragment), programs[0].stages[1].sourceBytes);
+
+  // Unlabeled programs are named by source hash.
+  EXPECT_EQ(gls::hashShaderSources(sources), programs[1].sourceHash);
+  EXPECT_EQ(16, programs[1].getName().size());
+
+  EXPECT_FALSE(programs[2].success);
+  EXPECT_FALSE(programs[2].linkLog.empty());
+
+  EXPECT_EQ(3, telemetry.getSlowest(10).size());
+  EXPECT_EQ(1, telemetry.getSlowest(1).size());
+
+  std::ostringstream json;
+  telemetry.writeJSON(json, 2);
+  EXPECT_NE(std::string::npos, json.str().find("\"num_failed\": 1"));
+  EXPECT_NE(std::string::npos, json.str().find("\"Broken\""));
+}
@@ -0,0 +1,138 @@
+/// \date   October 2026
+
+#include <gtest/gtest.h>
+#include <sstream>
+#include <thread>
+#include <chrono>
+
+#include <gl-shaders/GLShader.hpp>
+#include <gl-shaders/GLShaderUsage.hpp>
+#include <gl-shaders/GLNullBackend.hpp>
+
+namespace gls = CPM_GL_SHADERS_NS;
+
+TEST(ShaderUsage, RecordLoads)
+{
+  gls::ShaderUsageRecorder recorder;
+  recorder.recordLoad(0xAAAA, 1, 3);
+  recorder.recordLoad(0xBBBB);
+  recorder.recordLoad(0xAAAA, 1, 3);
+
+  std::vector<gls::ShaderUsageEntry> profile = recorder.getProfile();
+  ASSERT_EQ(2, profile.size());
+  EXPECT_EQ(0xAAAA, profile[0].sourceHash);
+  EXPECT_EQ(2, profile[0].loadCount);
+  EXPECT_EQ(3, profile[0].features);
+  EXPECT_EQ(1, profile[1].loadCount);
+  EXPECT_LE(profile[0].firstUse, profile[1].firstUse);
+
+  recorder.beginSession();
+  EXPECT_TRUE(recorder.getProfile().empty());
+}
+
+TEST(ShaderUsage, RecordsLoadedPrograms)
+{
+  gls::NullGLBackend backend;
+  gls::ShaderUsageRecorder recorder;
+  EXPECT_EQ(nullptr, gls::setShaderUsageRecorder(&recorder));
+
+  std::list<gls::ShaderSource> colored =
+  {
+    gls::ShaderSource({"void main() { gl_Position = vec4(0.0); }"}, GL_VERTEX_SHADER),
+    gls::ShaderSource({"void main() {}"}, GL_FRAGMENT_SHADER),
+  };
+  std::list<gls::ShaderSource> textured =
+  {
+    gls::ShaderSource({"void main() { gl_Position = vec4(1.0); }"}, GL_VERTEX_SHADER),
+    gls::ShaderSource({"void main() {}"}, GL_FRAGMENT_SHADER),
+  };
+
+  gls::loadShaderProgram(colored);
+  gls::loadShaderProgram(textured, "Textured");
+  gls::loadShaderProgram(colored);
+
+  // Failed loads are not recorded.
+  backend.setLinkStatus(false);
+  EXPECT_THROW(gls::loadShaderProgram(textured), std::runtime_error);
+  backend.setLinkStatus(true);
+
+  EXPECT_EQ(&recorder, gls::setShaderUsageRecorder(nullptr));
+  gls::loadShaderProgram(textured);
+
+  std::vector<gls::ShaderUsageEntry> profile = recorder.getProfile();
+  ASSERT_EQ(2, profile.size());
+  EXPECT_EQ(gls::hashShaderSources(colored), profile[0].sourceHash);
+  EXPECT_EQ(2, profile[0].loadCount);
+  EXPECT_EQ(0, profile[0].baseID);
+  EXPECT_EQ(gls::hashShaderSources(textured), profile[1].sourceHash);
+  EXPECT_EQ(1, profile[1].loadCount);
+}
+
+TEST(ShaderUsage, ProfileRoundTrip)
+{
+  gls::ShaderUsageRecorder recorder;
+  recorder.recordLoad(0xFEDCBA9876543210ull, 7, 0x8000000000000001ull);
+  recorder.recordLoad(0x1234, 0, 0);
+  recorder.recordLoad(0x1234, 0, 0);
+  std::vector<gls::ShaderUsageEntry> saved = recorder.getProfile();
+
+  std::stringstream stream;
+  recorder.saveProfile(stream);
+  stream << "not a profile line\n";
+  std::vector<gls::ShaderUsageEntry> loaded = gls::ShaderUsageRecorder::loadProfile(stream);
+
+  ASSERT_EQ(saved.size(), loaded.size());
+  for (size_t i = 0; i < saved.size(); ++i)
+  {
+    EXPECT_EQ(saved[i].sourceHash, loaded[i].sourceHash);
+    EXPECT_EQ(saved[i].baseID, loaded[i].baseID);
+    EXPECT_EQ(saved[i].features, loaded[i].features);
+    EXPECT_EQ(saved[i].firstUse, loaded[i].firstUse);
+    EXPECT_EQ(saved[i].loadCount, loaded[i].loadCount);
+  }
+
+  EXPECT_TRUE(gls::ShaderUsageRecorder::loadProfile("/nonexistent/profile.txt").empty());
+}
+
+TEST(ShaderUsage, WarmupOrder)
+{
+  // Earliest first use first; ties broken by higher load count.
+  std::vector<gls::ShaderUsageEntry> profile(4);
+  profile[0].sourceHash = 1; profile[0].firstUse = 2.0; profile[0].loadCount = 9;
+  profile[1].sourceHash = 2; profile[1].firstUse = 0.5; profile[1].loadCount = 1;
+  profile[2].sourceHash = 3; profile[2].firstUse = 0.5; profile[2].loadCount = 4;
+  profile[3].sourceHash = 4; profile[3].firstUse = 1.0; profile[3].loadCount = 1;
+
+  std::vector<uint64_t> order;
+  gls::ShaderWarmupScheduler scheduler(profile, [&order](const gls::ShaderUsageEntry& entry)
+  {
+    order.push_back(entry.sourceHash);
+  });
+  EXPECT_EQ(4, scheduler.step(60.0));
+  EXPECT_TRUE(scheduler.isDone());
+  EXPECT_EQ(std::vector<uint64_t>({3, 2, 4, 1}), order);
+}
+
+TEST(ShaderUsage, WarmupBudget)
+{
+  std::vector<gls::ShaderUsageEntry> profile(4);
+  size_t numCompiled = 0;
+  gls::ShaderWarmupScheduler scheduler(profile, [&numCompiled](const gls::ShaderUsageEntry&)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    if (++numCompiled == 2) throw std::runtime_error("Failed to compile.");
+  });
+
+  // Each compile exceeds the budget, so every step compiles exactly one
+  // program. A budget of 0 still makes progress.
+  EXPECT_EQ(1, scheduler.step(0.001));
+  EXPECT_EQ(3, scheduler.getNumRemaining());
+  EXPECT_EQ(1, scheduler.step(0.0));
+  EXPECT_EQ(2, scheduler.getNumRemaining());
+
+  // Failures are reported and skipped.
+  EXPECT_EQ(2, scheduler.step(60.0));
+  EXPECT_TRUE(scheduler.isDone());
+  EXPECT_EQ(0, scheduler.step(0.0));
+  EXPECT_EQ(4, numCompiled);
+}
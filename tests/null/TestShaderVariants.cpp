@@ -0,0 +1,237 @@
+/// \date   October 2026
+
+#include <gtest/gtest.h>
+
+#include <gl-shaders/GLShaderVariants.hpp>
+#include <gl-shaders/GLDispatch.hpp>
+#include <gl-shaders/GLNullBackend.hpp>
+
+namespace gls = CPM_GL_SHADERS_NS;
+
+namespace {
+
+gls::ShaderVariantBase makeTestBase()
+{
+  gls::ShaderVariantBase base;
+  base.header = "#version 330\n";
+  base.stages.push_back(gls::ShaderVariantBase::Stage(GL_VERTEX_SHADER, "void main() {}\n"));
+  base.stages.push_back(gls::ShaderVariantBase::Stage(GL_FRAGMENT_SHADER, "void main() {}\n"));
+  base.featureNames = {"USE_LIGHTS", "USE_SHADOW", "USE_DETAIL"};
+  return base;
+}
+
+/// Estimated size of a variant when the driver reports no binary length.
+size_t getVariantSourceBytes(const gls::ShaderVariantBase& base, uint64_t features)
+{
+  size_t bytes = 0;
+  std::vector<std::string> strings = gls::ShaderVariantManager::buildVariantStrings(base, features);
+  for (auto it = strings.begin(); it != strings.end(); ++it)
+  {
+    bytes += it->size();
+  }
+  return bytes;
+}
+
+} // anonymous namespace
+
+TEST(ShaderVariants, BuildVariantStrings)
+{
+  std::vector<std::string> strings =
+      gls::ShaderVariantManager::buildVariantStrings(makeTestBase(), 5);
+  ASSERT_EQ(2, strings.size());
+  EXPECT_EQ("#version 330\n#define USE_LIGHTS\n#define USE_DETAIL\nvoid main() {}\n", strings[0]);
+}
+
+TEST(ShaderVariants, CompileOnFirstRequest)
+{
+  gls::NullGLBackend backend;
+  gls::ShaderVariantManager manager;
+  manager.registerBase(1, makeTestBase());
+  manager.setFallbackProgram(100);
+
+  gls::GLCallRecorder recorder;
+
+  // The first request queues the variant and answers with the fallback.
+  EXPECT_EQ(100, manager.getProgram(1, 3));
+  EXPECT_EQ(100, manager.getProgram(1, 3));
+  EXPECT_EQ(1, manager.getNumPending());
+  EXPECT_EQ(0, recorder.getCount(gls::GLCall::CreateProgram));
+  EXPECT_THROW(manager.getProgram(2, 0), std::runtime_error);
+
+  EXPECT_EQ(1, manager.processPending(4));
+  EXPECT_EQ(0, manager.getNumPending());
+  EXPECT_EQ(1, recorder.getCount(gls::GLCall::CreateProgram));
+
+  GLuint program = manager.getProgram(1, 3);
+  EXPECT_NE(100, program);
+  EXPECT_EQ(program, manager.getProgram(1, 3));
+  EXPECT_EQ(1, backend.getNumLivePrograms());
+
+  const gls::ShaderVariantManager::Stats& stats = manager.getStats();
+  EXPECT_EQ(2, stats.hits);
+  EXPECT_EQ(2, stats.misses);
+  EXPECT_EQ(1, stats.compiles);
+  EXPECT_EQ(0, stats.failures);
+
+  manager.resetStats();
+  EXPECT_EQ(0, manager.getStats().hits);
+}
+
+TEST(ShaderVariants, ProcessPendingBudget)
+{
+  gls::NullGLBackend backend;
+  gls::ShaderVariantManager manager;
+  manager.registerBase(1, makeTestBase());
+
+  for (uint64_t features = 0; features < 5; ++features)
+  {
+    manager.getProgram(1, features);
+  }
+  EXPECT_EQ(2, manager.processPending(2));
+  EXPECT_EQ(3, manager.getNumPending());
+  EXPECT_EQ(3, manager.processPending(10));
+  EXPECT_EQ(5, manager.getNumResident());
+}
+
+TEST(ShaderVariants, EvictLeastRecentlyUsedByCount)
+{
+  gls::NullGLBackend backend;
+  gls::ShaderVariantManager manager(2, 0);
+  manager.registerBase(1, makeTestBase());
+
+  EXPECT_TRUE(manager.precompile(1, 0));
+  EXPECT_TRUE(manager.precompile(1, 1));
+  manager.getProgram(1, 0);                 // Variant 1 is now least recent.
+  EXPECT_TRUE(manager.precompile(1, 2));
+
+  EXPECT_EQ(2, manager.getNumResident());
+  EXPECT_EQ(2, backend.getNumLivePrograms());
+  EXPECT_EQ(1, manager.getStats().evictions);
+
+  manager.resetStats();
+  manager.getProgram(1, 0);
+  manager.getProgram(1, 2);
+  EXPECT_EQ(2, manager.getStats().hits);
+  manager.getProgram(1, 1);
+  EXPECT_EQ(1, manager.getStats().misses);
+}
+
+TEST(ShaderVariants, EvictLeastRecentlyUsedByBytes)
+{
+  gls::NullGLBackend backend;
+  gls::ShaderVariantBase base = makeTestBase();
+  size_t variantBytes = getVariantSourceBytes(base, 1);
+  ASSERT_EQ(variantBytes, getVariantSourceBytes(base, 2));
+  ASSERT_EQ(variantBytes, getVariantSourceBytes(base, 4));
+
+  // Room for two single-feature variants, not three.
+  gls::ShaderVariantManager manager(0, 2 * variantBytes + 1);
+  manager.registerBase(1, base);
+
+  manager.precompile(1, 1);
+  manager.precompile(1, 2);
+  EXPECT_EQ(2 * variantBytes, manager.getResidentBytes());
+  manager.getProgram(1, 1);
+  manager.precompile(1, 4);
+
+  EXPECT_EQ(2, manager.getNumResident());
+  EXPECT_EQ(2 * variantBytes, manager.getResidentBytes());
+  EXPECT_EQ(1, manager.getStats().evictions);
+
+  // Shrinking the budget evicts immediately, but keeps the most recent.
+  manager.setBudget(0, 1);
+  EXPECT_EQ(1, manager.getNumResident());
+  EXPECT_EQ(1, backend.getNumLivePrograms());
+}
+
+TEST(ShaderVariants, FailedVariantIsNotRetried)
+{
+  gls::NullGLBackend backend;
+  gls::ShaderVariantManager manager;
+  manager.registerBase(1, makeTestBase());
+  manager.setFallbackProgram(100);
+
+  backend.setCompileStatus(false);
+  manager.getProgram(1, 1);
+  EXPECT_EQ(1, manager.processPending(1));
+  EXPECT_EQ(1, manager.getStats().failures);
+  EXPECT_EQ(0, backend.getNumLivePrograms());
+  EXPECT_EQ(0, backend.getNumLiveShaders());
+
+  // Later requests get the fallback and do not queue the variant again, even
+  // once it would compile.
+  backend.setCompileStatus(true);
+  EXPECT_EQ(100, manager.getProgram(1, 1));
+  EXPECT_EQ(0, manager.getNumPending());
+  EXPECT_FALSE(manager.precompile(1, 1));
+
+  // Registering the base shader again clears the failure.
+  manager.registerBase(1, makeTestBase());
+  EXPECT_TRUE(manager.precompile(1, 1));
+  EXPECT_NE(100, manager.getProgram(1, 1));
+}
+
+TEST(ShaderVariants, SpirvSourceHash)
+{
+  uint32_t module[2]      = {0x07230203, 1};
+  uint32_t otherModule[2] = {0x07230203, 2};
+  uint64_t hash = gls::hashShaderSource(
+      gls::ShaderSource(module, sizeof(module), GL_FRAGMENT_SHADER, "main", {1}, {0}));
+
+  EXPECT_EQ(hash, gls::hashShaderSource(
+      gls::ShaderSource(module, sizeof(module), GL_FRAGMENT_SHADER, "main", {1}, {0})));
+  EXPECT_NE(hash, gls::hashShaderSource(
+      gls::ShaderSource(otherModule, sizeof(otherModule), GL_FRAGMENT_SHADER, "main", {1}, {0})));
+  EXPECT_NE(hash, gls::hashShaderSource(
+      gls::ShaderSource(module, sizeof(module), GL_FRAGMENT_SHADER, "mainAlt", {1}, {0})));
+  EXPECT_NE(hash, gls::hashShaderSource(
+      gls::ShaderSource(module, sizeof(module), GL_FRAGMENT_SHADER, "main", {2}, {0})));
+  EXPECT_NE(hash, gls::hashShaderSource(
+      gls::ShaderSource(module, sizeof(module), GL_FRAGMENT_SHADER, "main", {1}, {1})));
+
+  EXPECT_THROW(gls::ShaderSource(module, sizeof(module), GL_FRAGMENT_SHADER, nullptr),
+               std::runtime_error);
+}
+
+TEST(ShaderVariants, SpirvBase)
+{
+  gls::NullGLBackend backend;
+  std::vector<uint32_t> module = {0x07230203, 0x00010000, 0, 1};
+
+  gls::ShaderVariantBase base;
+  base.stages.push_back(gls::ShaderVariantBase::Stage(GL_VERTEX_SHADER, module));
+  base.stages.push_back(gls::ShaderVariantBase::Stage(GL_FRAGMENT_SHADER, module, "fragMain"));
+  base.featureConstants = {3, 7};
+  EXPECT_EQ(std::vector<std::string>(2),
+            gls::ShaderVariantManager::buildVariantStrings(base, 3));
+
+  gls::ShaderUsageRecorder usage;
+  gls::ShaderVariantManager manager;
+  manager.registerBase(1, base);
+  manager.setUsageRecorder(&usage);
+
+  // Feature bits select specialization constant values, so every variant
+  // has its own source hash.
+  manager.getProgram(1, 0);
+  manager.getProgram(1, 1);
+  manager.getProgram(1, 2);
+  std::vector<gls::ShaderUsageEntry> profile = usage.getProfile();
+  ASSERT_EQ(3, profile.size());
+  EXPECT_NE(profile[0].sourceHash, profile[1].sourceHash);
+  EXPECT_NE(profile[1].sourceHash, profile[2].sourceHash);
+
+  gls::GLCallRecorder recorder;
+  EXPECT_EQ(3, manager.processPending(3));
+#ifdef GL_SHADER_BINARY_FORMAT_SPIR_V
+  EXPECT_EQ(3, manager.getStats().compiles);
+  EXPECT_EQ(6, recorder.getCount(gls::GLCall::ShaderBinary));
+  EXPECT_EQ(6, recorder.getCount(gls::GLCall::SpecializeShader));
+  EXPECT_EQ(0, recorder.getCount(gls::GLCall::ShaderSource));
+  EXPECT_EQ(2 * module.size() * sizeof(uint32_t), manager.getResidentBytes() / 3);
+#else
+  EXPECT_EQ(3, manager.getStats().failures);
+  EXPECT_THROW(gls::compileShader(
+                   gls::ShaderSource(&module[0], module.size() * sizeof(uint32_t), GL_VERTEX_SHADER)),
+               std::runtime_error);
+#endif
+}
@@ -0,0 +1,103 @@
+/// \date   October 2026
+
+#include <gtest/gtest.h>
+
+#include <gl-shaders/GLVertexLayout.hpp>
+
+namespace gls = CPM_GL_SHADERS_NS;
+
+TEST(VertexLayout, CanonicalIDs)
+{
+  std::vector<gls::ShaderAttribute> vbo =
+  {
+    gls::ShaderAttribute("aPos", 3, GL_FLOAT),
+    gls::ShaderAttribute("aNormal", 3, GL_FLOAT),
+    gls::ShaderAttribute("aColorFloat", 4, GL_FLOAT),
+  };
+  std::vector<gls::ShaderAttribute> vboReordered =
+  {
+    gls::ShaderAttribute("aNormal", 3, GL_FLOAT),
+    gls::ShaderAttribute("aPos", 3, GL_FLOAT),
+    gls::ShaderAttribute("aColorFloat", 4, GL_FLOAT),
+  };
+  std::vector<gls::ShaderAttribute> program =
+  {
+    gls::ShaderAttribute("aPos", 1, GL_FLOAT_VEC3, 1),
+    gls::ShaderAttribute("aColorFloat", 1, GL_FLOAT_VEC4, 0),
+  };
+  std::vector<gls::ShaderAttribute> programReordered(program.rbegin(), program.rend());
+
+  gls::VertexLayoutRegistry registry;
+  gls::VertexLayoutID vboID = registry.registerVertexLayout(vbo.data(), vbo.size());
+  EXPECT_EQ(vboID, registry.registerVertexLayout(vbo.data(), vbo.size()));
+
+  // VBO attribute order determines offsets; program attribute order does not.
+  EXPECT_NE(vboID, registry.registerVertexLayout(vboReordered.data(), vboReordered.size()));
+  gls::VertexLayoutID programID = registry.registerProgramLayout(program.data(), program.size());
+  EXPECT_EQ(programID, registry.registerProgramLayout(programReordered.data(), programReordered.size()));
+  EXPECT_EQ("aColorFloat", registry.getLayout(programID)[0].nameInCode);
+
+  // The same list registered as a program is a different layout.
+  EXPECT_NE(vboID, registry.registerProgramLayout(vbo.data(), vbo.size()));
+  EXPECT_EQ(4, registry.getNumLayouts());
+}
+
+TEST(VertexLayout, MemoizedAppliedLayout)
+{
+  std::vector<gls::ShaderAttribute> vbo =
+  {
+    gls::ShaderAttribute("aPos", 3, GL_FLOAT),
+    gls::ShaderAttribute("aNormal", 3, GL_FLOAT),
+    gls::ShaderAttribute("aColorFloat", 4, GL_FLOAT),
+  };
+  std::vector<gls::ShaderAttribute> program =
+  {
+    gls::ShaderAttribute("aColorFloat", 1, GL_FLOAT_VEC4, 0),
+    gls::ShaderAttribute("aPos", 1, GL_FLOAT_VEC3, 1),
+  };
+  std::vector<gls::ShaderAttribute> texturedProgram =
+  {
+    gls::ShaderAttribute("aPos", 1, GL_FLOAT_VEC3, 0),
+    gls::ShaderAttribute("aTexCoord", 1, GL_FLOAT_VEC2, 1),
+  };
+
+  gls::VertexLayoutRegistry registry;
+  gls::VertexLayoutID vboID      = registry.registerVertexLayout(vbo.data(), vbo.size());
+  gls::VertexLayoutID programID  = registry.registerProgramLayout(program.data(), program.size());
+  gls::VertexLayoutID texturedID = registry.registerProgramLayout(texturedProgram.data(), texturedProgram.size());
+
+  const gls::VertexLayoutRegistry::AppliedLayout& applied = registry.getAppliedLayout(vboID, programID);
+  ASSERT_TRUE(applied.compatible);
+  EXPECT_EQ(40, applied.stride);
+  ASSERT_EQ(2, applied.attributes.size());
+  EXPECT_EQ(1, applied.attributes[0].attribLoc);
+  EXPECT_EQ(0, applied.attributes[0].offset);
+  EXPECT_EQ(0, applied.attributes[1].attribLoc);
+  EXPECT_EQ(24, applied.attributes[1].offset);
+
+  EXPECT_FALSE(registry.isCompatible(vboID, texturedID));
+  EXPECT_EQ(&applied, &registry.getAppliedLayout(vboID, programID));
+  EXPECT_EQ(applied.attributes.data(), registry.getAppliedLayout(vboID, programID).attributes.data());
+
+  EXPECT_THROW(registry.getAppliedLayout(programID, vboID), std::runtime_error);
+
+  // A default for the missing attribute makes the pair compatible.
+  registry.setAttributeDefaults({gls::ShaderAttributeDefault("aTexCoord", 0.0f, 0.0f)});
+  const gls::VertexLayoutRegistry::AppliedLayout& textured = registry.getAppliedLayout(vboID, texturedID);
+  ASSERT_TRUE(textured.compatible);
+  ASSERT_EQ(1, textured.attributes.size());
+  EXPECT_EQ(0, textured.attributes[0].attribLoc);
+  ASSERT_EQ(1, textured.constants.size());
+  EXPECT_EQ(1, textured.constants[0].attribLoc);
+  EXPECT_TRUE(registry.getAppliedLayout(vboID, programID).constants.empty());
+
+  // Layouts built under earlier defaults stay valid.
+  const gls::ShaderAttributeApplied* texturedAttributes = textured.attributes.data();
+  registry.setAttributeDefaults({});
+  EXPECT_TRUE(textured.compatible);
+  EXPECT_EQ(texturedAttributes, textured.attributes.data());
+  EXPECT_EQ(1, textured.constants.size());
+  EXPECT_EQ(2, applied.attributes.size());
+  EXPECT_NE(&applied, &registry.getAppliedLayout(vboID, programID));
+  EXPECT_FALSE(registry.isCompatible(vboID, texturedID));
+}
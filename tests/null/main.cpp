@@ -0,0 +1,11 @@
+/// \date   October 2026
+
+#include <gtest/gtest.h>
+
+// Tests in this directory run against NullGLBackend and must not require an
+// OpenGL context, so no global test environment is installed.
+int main(int argc, char** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
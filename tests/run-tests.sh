@@ -13,6 +13,7 @@ pushd ./bin > /dev/null
     cmake -DCMAKE_BUILD_TYPE=Debug -DUSE_OS_MESA=ON ..
   fi
   make -j4
+  ./gl_shader_null_tests
   ./gl_shader_tests
 popd
 